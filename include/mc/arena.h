@@ -0,0 +1,78 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// All allocations are aligned to this.
+#define MC_ARENA_ALIGN 8
+
+// Size rounded up to alignment.
+#define MC_ARENA_ALIGN_SIZE(SIZE) \
+    (((SIZE) + MC_ARENA_ALIGN - 1) / MC_ARENA_ALIGN * MC_ARENA_ALIGN)
+
+// Macro for defining arena of SIZE bytes. Users should always use this.
+#define MC_DEFINE_ARENA(NAME, SIZE)                           \
+    static uint64_t NAME##_buffer[MC_ARENA_ALIGN_SIZE(SIZE) / \
+                                  sizeof(uint64_t)];          \
+    static mc_arena_state_t NAME##_state = {0};               \
+    const mc_arena_t NAME = {                                 \
+        .buffer = (uint8_t *)NAME##_buffer,                   \
+        .size = MC_ARENA_ALIGN_SIZE(SIZE),                    \
+        .state = &NAME##_state}
+
+    // Position in the arena, returned by mc_arena_mark.
+    typedef uint32_t mc_arena_mark_t;
+
+    /* Arena state. */
+    typedef struct mc_arena_state_t
+    {
+        uint32_t offset;
+        uint32_t high_water;
+        uint32_t failure_count;
+        uint8_t is_initialized;
+    } mc_arena_state_t;
+
+    /* Bump allocator for scratch memory. Allocations are only freed in bulk,
+     * by resetting to a mark. */
+    typedef struct mc_arena_t
+    {
+        uint8_t *buffer;
+        uint32_t size;
+        mc_arena_state_t *state;
+    } mc_arena_t;
+
+    /* Arena statistics. */
+    typedef struct mc_arena_stats_t
+    {
+        uint32_t size;
+        uint32_t used;
+        uint32_t high_water;
+        uint32_t failure_count;
+    } mc_arena_stats_t;
+
+    /* Initialize arena. Frees everything and resets statistics. */
+    void mc_arena_init(const mc_arena_t *arena);
+
+    /* Allocate size bytes. Returns NULL if the arena has no room left. */
+    void *mc_arena_alloc(const mc_arena_t *arena, uint32_t size);
+
+    /* Get the current position, to reset to later. */
+    mc_arena_mark_t mc_arena_mark(const mc_arena_t *arena);
+
+    /* Free everything allocated since the mark was taken. */
+    void mc_arena_reset_to(const mc_arena_t *arena, mc_arena_mark_t mark);
+
+    /* Free everything. */
+    void mc_arena_reset(const mc_arena_t *arena);
+
+    /* Get arena statistics. */
+    void mc_arena_get_stats(const mc_arena_t *arena, mc_arena_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -6,6 +6,12 @@ extern "C"
 #endif
 
 #include "mc/list.h"
+#include "mc/status.h"
+
+// Set to 1 to record per-event trigger counts and per-callback timing.
+#ifndef MC_EVENT_PROFILING
+#define MC_EVENT_PROFILING 0
+#endif
 
 // Macro for defining event and callback. Users should always use this.
 #define MC_DEFINE_EVENT(NAME) static mc_event_t NAME = {0}
@@ -16,16 +22,86 @@ extern "C"
         .func = FUNC,                       \
         .ctx = &CTX}
 
+// Callbacks with higher priority run first. Same priority runs in
+// registration order.
+#define MC_DEFINE_CALLBACK_WITH_PRIORITY(NAME, FUNC, CTX, PRIORITY) \
+    static mc_callback_t NAME = {                                   \
+        .node = {0},                                                \
+        .func = FUNC,                                               \
+        .ctx = &CTX,                                                \
+        .priority = PRIORITY}
+
+// Filters can return MC_EVENT_STOP to skip all lower priority callbacks.
+#define MC_DEFINE_FILTER(NAME, FUNC, CTX, PRIORITY) \
+    static mc_callback_t NAME = {                   \
+        .node = {0},                                \
+        .func = NULL,                               \
+        .ctx = &CTX,                                \
+        .filter = FUNC,                             \
+        .priority = PRIORITY}
+
+// Macro for defining an event whose handlers are fixed at build time. The
+// handler table is const, so it stays in flash. Handlers are called with a NULL
+// ctx. Dynamic listeners can still be added with mc_static_event_register.
+#define MC_DEFINE_STATIC_EVENT(NAME, ...)                              \
+    static const mc_callback_func_t NAME##_handlers[] = {__VA_ARGS__}; \
+    static mc_event_t NAME##_dynamic = {0};                            \
+    static const mc_static_event_t NAME = {                            \
+        .handlers = NAME##_handlers,                                   \
+        .count = sizeof(NAME##_handlers) / sizeof(NAME##_handlers[0]), \
+        .dynamic = &NAME##_dynamic}
+
+// Macro for defining the pending event queue. LEN must not exceed 32768.
+#define MC_DEFINE_EVENT_QUEUE(NAME, LEN)               \
+    static mc_event_queue_entry_t NAME##_entries[LEN]; \
+    static mc_event_queue_state_t NAME##_state = {0};  \
+    static const mc_event_queue_t NAME = {             \
+        .entries = NAME##_entries,                     \
+        .capacity = LEN,                               \
+        .state = &NAME##_state}
+
     /* Callback function: takes in void pointer pointing to context and event data.
      * ctx: User data stored with the subscription (e.g., "MyObject*")
      * e:   Event data passed when the event fires (e.g., "Keycode")
      */
     typedef void (*mc_callback_func_t)(void *ctx, void *e);
 
+    /* Whether the event should keep going to the next callback. */
+    typedef enum mc_event_action_t
+    {
+        MC_EVENT_CONTINUE = 0,
+        MC_EVENT_STOP = 1
+    } mc_event_action_t;
+
+    /* Filter function: same as mc_callback_func_t, but can stop propagation. */
+    typedef mc_event_action_t (*mc_filter_func_t)(void *ctx, void *e);
+
+    /* Default callback priority. */
+#define MC_EVENT_PRIORITY_DEFAULT 0
+
+    /* Callback timing statistics, in microseconds. */
+    typedef struct mc_callback_stats_t
+    {
+        uint32_t call_count;
+        uint32_t min_us;
+        uint32_t max_us;
+        uint64_t total_us;
+    } mc_callback_stats_t;
+
     /* Event struct. */
     typedef struct mc_event_t
     {
         mc_list_t listeners;
+#if MC_EVENT_PROFILING
+        uint32_t trigger_count;
+        const char *name;
+        mc_node_t profile_node; // Link in the list dumped by the console.
+#endif
+
+        // Used by mc_event_post_coalesced. Latest data and whether the event
+        // is already sitting in the pending queue.
+        void *volatile pending_data;
+        volatile bool is_pending;
     } mc_event_t;
 
     /* Callback struct. */
@@ -34,15 +110,61 @@ extern "C"
         mc_node_t node;
         mc_callback_func_t func;
         void *ctx;
+        mc_filter_func_t filter; // If set, used instead of func.
+        int8_t priority;
+#if MC_EVENT_PROFILING
+        mc_callback_stats_t stats;
+#endif
     } mc_callback_t;
 
+    /* Event with a build time handler table. */
+    typedef struct mc_static_event_t
+    {
+        const mc_callback_func_t *handlers;
+        uint16_t count;
+        mc_event_t *dynamic;
+    } mc_static_event_t;
+
+    /* Pending queue entry. */
+    typedef struct mc_event_queue_entry_t
+    {
+        mc_event_t *event;
+        void *data;
+        bool is_coalesced;
+    } mc_event_queue_entry_t;
+
+    /* Pending queue state. head is only written by producers, tail only by
+     * mc_event_dispatch_pending. Both are positions in [0, 2 * capacity). */
+    typedef struct mc_event_queue_state_t
+    {
+        volatile uint16_t head;
+        volatile uint16_t tail;
+        volatile uint16_t dropped;
+        uint8_t is_initialized;
+    } mc_event_queue_state_t;
+
+    /* Pending queue struct. */
+    typedef struct mc_event_queue_t
+    {
+        mc_event_queue_entry_t *entries;
+        uint16_t capacity;
+        mc_event_queue_state_t *state;
+    } mc_event_queue_t;
+
     /* Initialize event. */
     void mc_event_init(mc_event_t *event);
 
     /* Initialize callback. */
     void mc_callback_init(mc_callback_t *cb, mc_callback_func_t func, void *ctx);
 
-    /* Register callback to event. */
+    /* Initialize filter callback. */
+    void mc_filter_init(mc_callback_t *cb, mc_filter_func_t filter, void *ctx,
+                        int8_t priority);
+
+    /* Set callback priority. Must be called before registering. */
+    void mc_callback_set_priority(mc_callback_t *cb, int8_t priority);
+
+    /* Register callback to event. Sorted by priority, highest first. */
     void mc_event_register(mc_event_t *event, mc_callback_t *cb);
 
     /* Unregister callback to event. */
@@ -51,6 +173,64 @@ extern "C"
     /* Trigger event. */
     void mc_event_trigger(mc_event_t *event, void *event_data);
 
+    /* Trigger static event. Static handlers run first, then dynamic ones. */
+    void mc_static_event_trigger(const mc_static_event_t *event,
+                                 void *event_data);
+
+    /* Register dynamic callback to static event. */
+    void mc_static_event_register(const mc_static_event_t *event,
+                                  mc_callback_t *cb);
+
+    /* Unregister dynamic callback from static event. */
+    void mc_static_event_unregister(const mc_static_event_t *event,
+                                    mc_callback_t *cb);
+
+    /* Set the queue used by mc_event_post and mc_event_dispatch_pending. */
+    void mc_event_queue_init(const mc_event_queue_t *queue);
+
+    /**
+     * Queue the event to be triggered later by mc_event_dispatch_pending.
+     * Safe to call from a single interrupt context while the main loop
+     * dispatches. Returns MC_ERROR_NO_RESOURCE if the queue is full.
+     */
+    mc_status_t mc_event_post(mc_event_t *event, void *event_data);
+
+    /**
+     * Same as mc_event_post, but if the event is already pending only its data
+     * is replaced. Listeners then run once with the latest data.
+     */
+    mc_status_t mc_event_post_coalesced(mc_event_t *event, void *event_data);
+
+    /**
+     * Trigger every event that was pending when this was called. Events posted
+     * by listeners run on the next call. Returns number of events triggered.
+     */
+    uint16_t mc_event_dispatch_pending(void);
+
+    /* Get number of pending events. */
+    uint16_t mc_event_get_pending_count(void);
+
+    /* Get number of posts dropped because the queue was full. */
+    uint16_t mc_event_get_dropped_count(void);
+
+#if MC_EVENT_PROFILING
+    /* Add event to the list of profiled events, so it shows up in dumps. Call
+     * once per event. */
+    void mc_event_profile_register(mc_event_t *event, const char *name);
+
+    /* Get the list of profiled events. Nodes are mc_event_t::profile_node. */
+    mc_list_t *mc_event_profile_get_events(void);
+
+    /* Get number of times the event was triggered. */
+    uint32_t mc_event_get_trigger_count(const mc_event_t *event);
+
+    /* Get average callback execution time in microseconds. */
+    uint32_t mc_callback_get_avg_us(const mc_callback_t *cb);
+
+    /* Reset trigger count and the stats of every registered callback. */
+    void mc_event_profile_reset(mc_event_t *event);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
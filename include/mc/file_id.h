@@ -0,0 +1,36 @@
+#pragma once
+
+/* File IDs reported by compact asserts (MC_ASSERT_COMPACT). Each source file
+ * defines MC_FILE_ID to its entry before any include. Append new files at the
+ * end so existing IDs keep their meaning in crash logs. */
+typedef enum mc_file_id_t
+{
+    MC_FILE_ID_UNKNOWN = 0,                // Application and test code
+    MC_FILE_ID_ARENA = 1,                  // arena.c
+    MC_FILE_ID_STREAM = 2,                 // stream.c
+    MC_FILE_ID_DEBUG = 3,                  // debug.c
+    MC_FILE_ID_ANALOG = 4,                 // analog.c
+    MC_FILE_ID_ANALOG_VECTOR3 = 5,         // analog_vector3.c
+    MC_FILE_ID_DIGITAL = 6,                // digital.c
+    MC_FILE_ID_EVENT = 7,                  // event.c
+    MC_FILE_ID_LATEST_EVENT = 8,           // latest_event.c
+    MC_FILE_ID_LIST = 9,                   // list.c
+    MC_FILE_ID_POOL = 10,                  // pool.c
+    MC_FILE_ID_RESOURCE = 11,              // resource.c
+    MC_FILE_ID_STATUS = 12,                // status.c
+    MC_FILE_ID_SYS_BINARY_CONSOLE = 13,    // binary_console.c
+    MC_FILE_ID_SYS_COMPOSITE = 14,         // composite.c
+    MC_FILE_ID_SYS_CONSOLE = 15,           // console.c
+    MC_FILE_ID_SYS_CORE = 16,              // core.c
+    MC_FILE_ID_ANALOG_SYSTEM = 17,         // analog_system.c
+    MC_FILE_ID_ANALOG_VECTOR3_SYSTEM = 18, // analog_vector3_system.c
+    MC_FILE_ID_DIGITAL_SYSTEM = 19,        // digital_system.c
+    MC_FILE_ID_PID_SYSTEM = 20,            // pid_system.c
+    MC_FILE_ID_SYS_REGISTRY = 21,          // registry.c
+    MC_FILE_ID_SYS_SCHEDULER = 22,         // scheduler.c
+    MC_FILE_ID_SYS_SNAPSHOT = 23,          // snapshot.c
+    MC_FILE_ID_SYS_SUBSCRIPTION = 24,      // subscription.c
+    MC_FILE_ID_SYS_TRANSACTION = 25,       // transaction.c
+    MC_FILE_ID_TIME = 26,                  // time.c
+    MC_FILE_ID_UTILS = 27,                 // utils.c
+} mc_file_id_t;
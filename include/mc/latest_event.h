@@ -0,0 +1,79 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "mc/event.h"
+
+// Macro for defining latest value event. Users should always use this.
+// TYPE is the value type, e.g. int32_t or mc_vector3_t.
+#define MC_DEFINE_LATEST_EVENT(NAME, TYPE)             \
+    static TYPE NAME##_pending;                        \
+    static TYPE NAME##_current;                        \
+    static mc_latest_event_state_t NAME##_state = {0}; \
+    static const mc_latest_event_t NAME = {            \
+        .pending = &NAME##_pending,                    \
+        .current = &NAME##_current,                    \
+        .size = sizeof(TYPE),                          \
+        .state = &NAME##_state}
+
+    /* Latest value event state. */
+    typedef struct mc_latest_event_state_t
+    {
+        mc_event_t event;
+        // Incremented before and after each publish, so it is odd while the
+        // pending value is being written.
+        volatile uint32_t sequence;
+        volatile bool is_dirty;
+        volatile uint32_t superseded_count;
+        uint8_t is_initialized;
+    } mc_latest_event_state_t;
+
+    /**
+     * Latest value event. Producers overwrite the pending value, and
+     * listeners run at most once per mc_latest_event_dispatch with the newest
+     * value. Event data: pointer to a copy of the value that stays valid until
+     * the next dispatch.
+     */
+    typedef struct mc_latest_event_t
+    {
+        void *pending;
+        void *current;
+        uint16_t size;
+        mc_latest_event_state_t *state;
+    } mc_latest_event_t;
+
+    /* Initialize latest value event. */
+    void mc_latest_event_init(const mc_latest_event_t *event);
+
+    /**
+     * Overwrite the pending value and mark it dirty. If the last value was not
+     * dispatched yet, it is counted as superseded. Safe to call from a single
+     * interrupt context while the main loop dispatches.
+     */
+    void mc_latest_event_publish(const mc_latest_event_t *event,
+                                 const void *value);
+
+    /* Trigger listeners with the newest value if dirty. Returns true if
+     * listeners were triggered. */
+    bool mc_latest_event_dispatch(const mc_latest_event_t *event);
+
+    /* Register callback to latest value event. */
+    void mc_latest_event_register(const mc_latest_event_t *event,
+                                  mc_callback_t *cb);
+
+    /* Unregister callback from latest value event. */
+    void mc_latest_event_unregister(const mc_latest_event_t *event,
+                                    mc_callback_t *cb);
+
+    /* Get number of values that were overwritten before being dispatched. */
+    uint32_t mc_latest_event_get_superseded_count(
+        const mc_latest_event_t *event);
+
+#ifdef __cplusplus
+}
+#endif
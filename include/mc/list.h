@@ -66,6 +66,10 @@ extern "C"
     /* Add a node to the front of the list. */
     void mc_list_prepend(mc_list_t *list, mc_node_t *node);
 
+    /* Insert a node before pos. If pos is NULL, node is appended. pos must be
+     * in the list. */
+    void mc_list_insert_before(mc_list_t *list, mc_node_t *pos, mc_node_t *node);
+
     /* Remove a node from the list. Note: to ensure O(1), we do NOT check if the
      * node actually exists in the list (only checked for easy cases, like head and
      * tail). */
@@ -0,0 +1,83 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Set to 1 to make alloc and free lock-free (CAS based), so they can be used
+// from interrupts. Needs atomic compare and swap support on the target.
+#ifndef MC_POOL_LOCK_FREE
+#define MC_POOL_LOCK_FREE 0
+#endif
+
+// All blocks are aligned to this.
+#define MC_POOL_ALIGN 8
+
+// Block size rounded up to alignment.
+#define MC_POOL_BLOCK_SIZE(SIZE) \
+    (((SIZE) + MC_POOL_ALIGN - 1) / MC_POOL_ALIGN * MC_POOL_ALIGN)
+
+// Number of 32-bit bitmap words needed for COUNT blocks.
+#define MC_POOL_BITMAP_WORDS(COUNT) (((COUNT) + 31) / 32)
+
+// Macro for defining pool of COUNT blocks of BLOCK_SIZE bytes.
+#define MC_DEFINE_POOL(NAME, BLOCK_SIZE, COUNT)                     \
+    static uint64_t NAME##_storage[MC_POOL_BLOCK_SIZE(BLOCK_SIZE) * \
+                                   (COUNT) / sizeof(uint64_t)];     \
+    static uint32_t NAME##_bitmap[MC_POOL_BITMAP_WORDS(COUNT)];     \
+    static mc_pool_state_t NAME##_state = {0};                      \
+    const mc_pool_t NAME = {                                        \
+        .storage = (uint8_t *)NAME##_storage,                       \
+        .bitmap = NAME##_bitmap,                                    \
+        .block_size = MC_POOL_BLOCK_SIZE(BLOCK_SIZE),               \
+        .block_count = COUNT,                                       \
+        .state = &NAME##_state}
+
+    /* Pool state. */
+    typedef struct mc_pool_state_t
+    {
+        uint16_t used_count;
+        uint16_t high_water;
+        uint32_t failure_count;
+        uint8_t is_initialized;
+    } mc_pool_state_t;
+
+    /* Fixed block pool. A set bitmap bit means the block is free. */
+    typedef struct mc_pool_t
+    {
+        uint8_t *storage;
+        uint32_t *bitmap;
+        uint16_t block_size;
+        uint16_t block_count;
+        mc_pool_state_t *state;
+    } mc_pool_t;
+
+    /* Pool statistics. */
+    typedef struct mc_pool_stats_t
+    {
+        uint16_t block_size;
+        uint16_t block_count;
+        uint16_t used_count;
+        uint16_t high_water;
+        uint32_t failure_count;
+    } mc_pool_stats_t;
+
+    /* Initialize pool. Frees all blocks and resets statistics. */
+    void mc_pool_init(const mc_pool_t *pool);
+
+    /* Allocate one block. Returns NULL if the pool is exhausted. */
+    void *mc_pool_alloc(const mc_pool_t *pool);
+
+    /* Return block to the pool. Block must come from this pool. */
+    void mc_pool_free(const mc_pool_t *pool, void *block);
+
+    /* Get pool statistics. */
+    void mc_pool_get_stats(const mc_pool_t *pool, mc_pool_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -2,6 +2,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "mc/status.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -18,21 +19,85 @@ extern "C"
         .pool = POOL,                                 \
         .count = COUNT}
 
+// Hash index length for a resource table. Keeps load factor at 50%.
+#define MC_RESOURCE_TABLE_INDEX_LEN(COUNT) ((COUNT) * 2)
+
+// Marks end of free list.
+#define MC_RESOURCE_NONE 0xFFFF
+
+// Invalid resource handle.
+#define MC_RESOURCE_INVALID_HANDLE 0xFFFFFFFF
+
+// Entries checked by acquire when the pool is full and leases are enabled.
+#ifndef MC_RESOURCE_TABLE_SWEEP_BUDGET
+#define MC_RESOURCE_TABLE_SWEEP_BUDGET 8
+#endif
+
+// Macro for defining resource table. COUNT must not exceed 32767.
+#define MC_DEFINE_RESOURCE_TABLE(NAME, POOL, COUNT) \
+    MC_DEFINE_RESOURCE_TABLE_WITH_LEASE(NAME, POOL, COUNT, 0)
+
+// Same as above, but entries expire LEASE_MS after being acquired or touched.
+// A lease of 0 never expires.
+#define MC_DEFINE_RESOURCE_TABLE_WITH_LEASE(NAME, POOL, COUNT, LEASE_MS)   \
+    static uint16_t NAME##_key_index[MC_RESOURCE_TABLE_INDEX_LEN(COUNT)];  \
+    static uint16_t NAME##_data_index[MC_RESOURCE_TABLE_INDEX_LEN(COUNT)]; \
+    static mc_resource_table_state_t NAME##_state = {0};                   \
+    const mc_resource_table_t NAME = {                                     \
+        .pool = POOL,                                                      \
+        .count = COUNT,                                                    \
+        .key_index = NAME##_key_index,                                     \
+        .data_index = NAME##_data_index,                                   \
+        .index_len = MC_RESOURCE_TABLE_INDEX_LEN(COUNT),                   \
+        .lease_ms = LEASE_MS,                                              \
+        .state = &NAME##_state}
+
     // Wrapper for a managed resource.
     typedef struct mc_resource_entry_t
     {
         void *data;
         int32_t key;
         bool is_busy;
+        // Only used by mc_resource_table_t.
+        uint16_t next;       // Next free entry.
+        uint16_t generation; // Incremented on release to detect stale handles.
+        uint32_t expires_ms; // Lease deadline.
     } mc_resource_entry_t;
 
+    // Handle to a resource table entry: generation << 16 | index.
+    typedef uint32_t mc_resource_handle_t;
+
     // The Resource Manager control structure.
     typedef struct mc_resource_manager_t
     {
         mc_resource_entry_t *pool;
-        uint8_t count;
+        uint16_t count;
     } mc_resource_manager_t;
 
+    // Resource table state.
+    typedef struct mc_resource_table_state_t
+    {
+        uint16_t free_head;
+        uint16_t used_count;
+        uint16_t sweep_cursor;
+        uint8_t is_initialized;
+    } mc_resource_table_state_t;
+
+    // Resource table. Same as the resource manager, but free entries are kept
+    // in a free list and keys and data pointers are found through open
+    // addressing hash indexes, so every operation is O(1) on average.
+    // Index slots hold entry index + 1, 0 means empty.
+    typedef struct mc_resource_table_t
+    {
+        mc_resource_entry_t *pool;
+        uint16_t count;
+        uint16_t *key_index;
+        uint16_t *data_index;
+        uint16_t index_len;
+        uint32_t lease_ms;
+        mc_resource_table_state_t *state;
+    } mc_resource_table_t;
+
     /**
      * Request a resource for a specific key.
      * * Logic:
@@ -51,6 +116,50 @@ extern "C"
     // Release whatever resource is holding this key.
     void mc_resource_release_key(const mc_resource_manager_t *mgr, int32_t key);
 
+    // Initialize table. Releases all entries and builds the indexes.
+    void mc_resource_table_init(const mc_resource_table_t *table);
+
+    // Same as mc_resource_acquire, in O(1).
+    void *mc_resource_table_acquire(const mc_resource_table_t *table,
+                                    int32_t key);
+
+    // Same as mc_resource_get, in O(1).
+    void *mc_resource_table_get(const mc_resource_table_t *table, int32_t key);
+
+    // Same as mc_resource_release, in O(1).
+    void mc_resource_table_release(const mc_resource_table_t *table,
+                                   void *resource);
+
+    // Same as mc_resource_release_key, in O(1).
+    void mc_resource_table_release_key(const mc_resource_table_t *table,
+                                       int32_t key);
+
+    // Same as mc_resource_table_acquire, but returns a handle. Returns
+    // MC_RESOURCE_INVALID_HANDLE if full.
+    mc_resource_handle_t mc_resource_table_acquire_handle(
+        const mc_resource_table_t *table, int32_t key);
+
+    // Get resource from handle. Returns NULL if the handle is stale or the
+    // lease expired.
+    void *mc_resource_table_resolve(const mc_resource_table_t *table,
+                                    mc_resource_handle_t handle);
+
+    // Renew the lease of the handle.
+    mc_status_t mc_resource_table_touch(const mc_resource_table_t *table,
+                                        mc_resource_handle_t handle);
+
+    // Release the resource of the handle. Stale handles are ignored.
+    void mc_resource_table_release_handle(const mc_resource_table_t *table,
+                                          mc_resource_handle_t handle);
+
+    // Check up to max_entries entries, continuing where the last sweep ended,
+    // and release the expired ones. Returns number of released entries.
+    uint16_t mc_resource_table_sweep(const mc_resource_table_t *table,
+                                     uint16_t max_entries);
+
+    // Get number of acquired entries.
+    uint16_t mc_resource_table_get_used_count(const mc_resource_table_t *table);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -21,6 +21,50 @@ typedef enum
     MC_ERROR_WRITE_PROTECTED = 12 // Flash/EEPROM is locked
 } mc_status_t;
 
+// Set to 1 to pack mc_result_t into a plain 64-bit integer. Composite types
+// wider than a register are returned through memory on most MCU ABIs, a
+// uint64_t comes back in a register pair.
+#ifndef MC_RESULT_COMPACT
+#define MC_RESULT_COMPACT 0
+#endif
+
+#if MC_RESULT_COMPACT
+
+/* Value or error. Low word holds value or error, high word is 0 if ok. */
+typedef uint64_t mc_result_t;
+
+// Helper for setting mc_result_t with value
+static inline mc_result_t MC_OK_VAL(int32_t val)
+{
+    return (uint32_t)val;
+}
+
+// Helper for setting mc_result_t with error
+static inline mc_result_t MC_ERR_VAL(mc_status_t err)
+{
+    return ((uint64_t)1 << 32) | (uint32_t)err;
+}
+
+// Helper for checking if mc_result_t holds a value
+static inline bool MC_RESULT_IS_OK(mc_result_t res)
+{
+    return (res >> 32) == 0;
+}
+
+// Helper for getting value of mc_result_t. Only valid if ok.
+static inline int32_t MC_RESULT_VALUE(mc_result_t res)
+{
+    return (int32_t)(uint32_t)res;
+}
+
+// Helper for getting error of mc_result_t. Only valid if not ok.
+static inline mc_status_t MC_RESULT_ERROR(mc_result_t res)
+{
+    return (mc_status_t)(uint32_t)res;
+}
+
+#else
+
 /* Struct containing value or error */
 typedef struct mc_result_t
 {
@@ -50,6 +94,26 @@ static inline mc_result_t MC_ERR_VAL(mc_status_t err)
     return res;
 }
 
+// Helper for checking if mc_result_t holds a value
+static inline bool MC_RESULT_IS_OK(mc_result_t res)
+{
+    return res.ok;
+}
+
+// Helper for getting value of mc_result_t. Only valid if ok.
+static inline int32_t MC_RESULT_VALUE(mc_result_t res)
+{
+    return res.value;
+}
+
+// Helper for getting error of mc_result_t. Only valid if not ok.
+static inline mc_status_t MC_RESULT_ERROR(mc_result_t res)
+{
+    return res.error;
+}
+
+#endif
+
 // Helper for converting mc_stauts_t to mc_result_t. If ok, value is 0.
 static inline mc_result_t MC_STATUS_TO_RESULT(mc_status_t status)
 {
@@ -74,9 +138,9 @@ const char *mc_status_to_string(mc_status_t status);
     do                                     \
     {                                      \
         mc_result_t _res = (expr);         \
-        if (!_res.ok)                      \
+        if (!MC_RESULT_IS_OK(_res))        \
         {                                  \
-            return _res.error;             \
+            return MC_RESULT_ERROR(_res);  \
         }                                  \
-        (out_var) = _res.value;            \
+        (out_var) = MC_RESULT_VALUE(_res); \
     } while (0)
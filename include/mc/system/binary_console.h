@@ -0,0 +1,127 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "mc/status.h"
+#include "mc/system/core.h"
+#include "mc/system/console.h"
+#include "mc/communication/stream.h"
+
+/*
+ * Binary console. Serves the same mc_system_entry_t table as the text console
+ * in compact frames for hosts that poll many values. Attach it instead of the
+ * text console to the streams that talk to such a host.
+ *
+ * Frame:    SYNC | LEN | PAYLOAD (LEN bytes) | CRC16 (little endian)
+ * Request:  REQ_ID | OPCODE | args...
+ * Response: REQ_ID | OPCODE + MC_SYS_BIN_RESPONSE | STATUS | data...
+ *
+ * The CRC (CRC-16/CCITT-FALSE) covers LEN and PAYLOAD. Frames with a bad CRC
+ * or a LEN over MC_SYS_BIN_MAX_PAYLOAD get no response. IDs and counts are
+ * unsigned LEB128 varints, values are zigzag varints. Data is only sent if
+ * STATUS is MC_OK.
+ *
+ * MC_SYS_BIN_OP_READ_OUTPUTS answers with n <= count items of STATUS and, if
+ * MC_OK, value. n is less than count when the response payload is full.
+ */
+
+// Largest payload of a request or response.
+#ifndef MC_SYS_BIN_MAX_PAYLOAD
+#define MC_SYS_BIN_MAX_PAYLOAD 64
+#endif
+#if MC_SYS_BIN_MAX_PAYLOAD > 255
+#error "MC_SYS_BIN_MAX_PAYLOAD must fit the LEN byte"
+#endif
+
+#define MC_SYS_BIN_SYNC 0xA5
+#define MC_SYS_BIN_RESPONSE 0x80
+
+// Sync, length and CRC bytes around the payload.
+#define MC_SYS_BIN_FRAME_OVERHEAD 4
+
+#define MC_DEFINE_SYSTEM_BINARY_CONSOLE(NAME, STREAM, SYSTEMS, SYS_COUNT,      \
+                                        ARGS_COUNT)                            \
+    static int32_t NAME##_args[ARGS_COUNT];                                    \
+    static uint8_t NAME##_rx_payload[MC_SYS_BIN_MAX_PAYLOAD];                  \
+    static uint8_t NAME##_tx_frame[MC_SYS_BIN_MAX_PAYLOAD +                    \
+                                   MC_SYS_BIN_FRAME_OVERHEAD];                 \
+    static const mc_system_binary_console_config_t NAME##_config =             \
+        {                                                                      \
+            .systems = SYSTEMS,                                                \
+            .system_count = SYS_COUNT,                                         \
+            .args_buffer = NAME##_args,                                        \
+            .args_count = ARGS_COUNT,                                          \
+            .rx_payload = NAME##_rx_payload,                                   \
+            .tx_frame = NAME##_tx_frame};                                      \
+    static mc_system_binary_console_state_t NAME##_state = {0};                \
+    static const mc_system_binary_console_t NAME =                             \
+        {                                                                      \
+            .stream = &STREAM,                                                 \
+            .config = &NAME##_config,                                          \
+            .state = &NAME##_state}
+
+    // Request opcodes, with their args and response data.
+    typedef enum mc_sys_bin_opcode_t
+    {
+        MC_SYS_BIN_OP_PING = 0x00,         // -> (none)
+        MC_SYS_BIN_OP_READ_INPUT = 0x01,   // sys, x -> value
+        MC_SYS_BIN_OP_WRITE_INPUT = 0x02,  // sys, x, value -> (none)
+        MC_SYS_BIN_OP_READ_OUTPUT = 0x03,  // sys, y -> value
+        MC_SYS_BIN_OP_READ_OUTPUTS = 0x04, // sys, first y, count -> n, n items
+        MC_SYS_BIN_OP_INVOKE = 0x05,       // sys, f, args... -> (none)
+    } mc_sys_bin_opcode_t;
+
+    // Struct for binary console config
+    typedef struct mc_system_binary_console_config_t
+    {
+        // List of systems, addressed by their ID.
+        const mc_system_entry_t *systems;
+        uint8_t system_count;
+
+        // Argument buffer used for MC_SYS_BIN_OP_INVOKE.
+        int32_t *args_buffer;
+        uint8_t args_count;
+
+        // MC_SYS_BIN_MAX_PAYLOAD bytes for the request being received.
+        uint8_t *rx_payload;
+
+        // MC_SYS_BIN_MAX_PAYLOAD + MC_SYS_BIN_FRAME_OVERHEAD bytes.
+        uint8_t *tx_frame;
+    } mc_system_binary_console_config_t;
+
+    // Struct for binary console state
+    typedef struct mc_system_binary_console_state_t
+    {
+        mc_callback_t rx_callback;
+        // Frame parser, frames may arrive split over several stream updates.
+        uint8_t rx_phase;
+        uint8_t rx_len;
+        uint8_t rx_index;
+        uint16_t rx_crc;
+        // Frames dropped for a bad CRC or length.
+        uint16_t dropped_count;
+        uint8_t is_initialized;
+    } mc_system_binary_console_state_t;
+
+    // Binary console struct.
+    typedef struct mc_system_binary_console_t
+    {
+        const mc_stream_t *stream;
+        const mc_system_binary_console_config_t *config;
+        mc_system_binary_console_state_t *state;
+    } mc_system_binary_console_t;
+
+    /* Initialize the binary console, attach it to a stream and switch the
+     * stream to MC_STREAM_MODE_BINARY_STREAM. */
+    void mc_sys_binary_console_init(const mc_system_binary_console_t *console);
+
+    /* Get the number of frames dropped for a bad CRC or length. */
+    uint16_t mc_sys_binary_console_get_dropped_count(
+        const mc_system_binary_console_t *console);
+
+#ifdef __cplusplus
+}
+#endif
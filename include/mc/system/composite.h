@@ -8,51 +8,134 @@ extern "C"
 #include "mc/system/core.h"
 #include <stddef.h>
 
+// Leaf table size of composites with nested composite children. Flat
+// composites need one entry per child and ignore this.
+#ifndef MC_COMPOSITE_MAX_LEAVES
+#define MC_COMPOSITE_MAX_LEAVES 64
+#endif
+
+// Instances of one composite driver, each with its own member table. Using
+// more instances asserts. Composites nested with MC_COMPOSITE_NODE use no
+// table of their own.
+#ifndef MC_COMPOSITE_DEFAULT_INSTANCES
+#define MC_COMPOSITE_DEFAULT_INSTANCES 4
+#endif
+
+    // Member kinds, columns of the prefix table.
+    typedef enum mc_composite_kind_t
+    {
+        MC_COMPOSITE_FUNCTIONS = 0,
+        MC_COMPOSITE_INPUTS,
+        MC_COMPOSITE_OUTPUTS,
+        MC_COMPOSITE_ALIASES,
+        MC_COMPOSITE_KIND_COUNT
+    } mc_composite_kind_t;
+
+    // Row i holds the member counts of leaves before leaf i, row leaf_count
+    // the totals.
+    typedef mc_sys_id_t mc_composite_prefix_t[MC_COMPOSITE_KIND_COUNT];
+
+    // Non-composite system reached through a composite.
+    typedef struct mc_composite_leaf_t
+    {
+        const mc_system_driver_t *driver;
+        size_t ctx_offset; // From the root composite's ctx
+    } mc_composite_leaf_t;
+
+    // Leaf table cache of one instance (RAM). Nested composites are flattened
+    // into it, so every member is one lookup away regardless of depth. Built
+    // on first use and rebuilt after mc_sys_invalidate of the instance,
+    // mc_sys_invalidate_all or when a leaf reports changed counts.
+    typedef struct mc_composite_cache_t
+    {
+        mc_composite_leaf_t *leaves;   // Same for all instances of a driver
+        mc_composite_prefix_t *prefix; // capacity + 1 rows
+        uint8_t capacity;
+        uint8_t leaf_count;
+        const void *ctx; // Instance, NULL if the slot is free
+        uint32_t generation;
+        bool is_valid;
+        bool has_changing_leaves; // Some leaf driver has counts_changed
+    } mc_composite_cache_t;
+
     // Struct to combine multiple system drivers into one bigger driver.
     typedef struct mc_composite_driver_t
     {
         uint8_t count;
         const mc_system_driver_t *const *systems;
         const size_t *ctx_offsets;
+        // Per child, the composite behind systems[i] or NULL
+        const struct mc_composite_driver_t *const *nested;
+        // Leaf table caches, one per instance.
+        mc_composite_cache_t *caches;
+        uint8_t cache_count;
+        mc_composite_leaf_t *leaves;   // capacity entries
+        mc_composite_prefix_t *prefix; // cache_count * (capacity + 1) rows
+        uint8_t capacity;
     } mc_composite_driver_t;
 
     // Trampoline methods for composite systems.
     void mc_composite_init(void *ctx, const mc_composite_driver_t *driver);
 
     mc_status_t mc_composite_invoke(
-        void *ctx, const mc_composite_driver_t *driver, uint8_t func_id,
+        void *ctx, const mc_composite_driver_t *driver, mc_sys_id_t func_id,
         int32_t *args, uint8_t arg_count);
 
     mc_status_t mc_composite_write_input(
-        void *ctx, const mc_composite_driver_t *driver, uint8_t x_id,
+        void *ctx, const mc_composite_driver_t *driver, mc_sys_id_t x_id,
         int32_t val);
 
     mc_result_t mc_composite_read_input(
-        void *ctx, const mc_composite_driver_t *driver, uint8_t x_id);
+        void *ctx, const mc_composite_driver_t *driver, mc_sys_id_t x_id);
 
     mc_result_t mc_composite_read_output(
-        void *ctx, const mc_composite_driver_t *driver, uint8_t y_id);
+        void *ctx, const mc_composite_driver_t *driver, mc_sys_id_t y_id);
+
+    mc_status_t mc_composite_read_outputs(
+        void *ctx, const mc_composite_driver_t *driver, mc_sys_id_t first_id,
+        mc_sys_id_t count, int32_t *values, mc_status_t *errors);
+
+    mc_status_t mc_composite_write_inputs(
+        void *ctx, const mc_composite_driver_t *driver, mc_sys_id_t first_id,
+        mc_sys_id_t count, const int32_t *values, mc_status_t *errors);
+
+    mc_status_t mc_composite_commit_inputs(
+        void *ctx, const mc_composite_driver_t *driver, mc_sys_id_t count,
+        const mc_sys_id_t *x_ids, const int32_t *values, mc_status_t *errors);
+
+    mc_status_t mc_composite_update(
+        void *ctx, const mc_composite_driver_t *driver, uint32_t dt_ms);
+
+    bool mc_composite_has_update(void *ctx,
+                                 const mc_composite_driver_t *driver);
+
+    bool mc_composite_counts_changed(void *ctx,
+                                     const mc_composite_driver_t *driver);
+
+    void mc_composite_invalidate(void *ctx,
+                                 const mc_composite_driver_t *driver);
 
     mc_status_t mc_composite_get_alias(
-        void *ctx, const mc_composite_driver_t *driver, uint8_t id,
+        void *ctx, const mc_composite_driver_t *driver, mc_sys_id_t id,
         mc_sys_cmd_info_t *info);
 
-    uint8_t mc_composite_get_function_count(
+    mc_sys_id_t mc_composite_get_function_count(
         void *ctx, const mc_composite_driver_t *driver);
 
-    uint8_t mc_composite_get_input_count(
+    mc_sys_id_t mc_composite_get_input_count(
         void *ctx, const mc_composite_driver_t *driver);
 
-    uint8_t mc_composite_get_output_count(
+    mc_sys_id_t mc_composite_get_output_count(
         void *ctx, const mc_composite_driver_t *driver);
 
-    uint8_t mc_composite_get_alias_count(
+    mc_sys_id_t mc_composite_get_alias_count(
         void *ctx, const mc_composite_driver_t *driver);
 
 // --- [Internal] Argument Mapping Helpers ---
-#define MC_GET_NTH_ARG(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, N, ...) N
+// Generated for up to 64 arguments.
+#define MC_GET_NTH_ARG(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, N, ...) N
 #define MC_COUNT_ARGS(...) \
-    MC_GET_NTH_ARG(__VA_ARGS__, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
+    MC_GET_NTH_ARG(__VA_ARGS__, 64, 63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49, 48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
 
 #define MC_INDIRECT_EXPAND(MACRO, ARGS) MACRO ARGS
 #define MC_MAP(FUNC, ...) \
@@ -68,93 +151,298 @@ extern "C"
 #define MC_MAP_IMPL_8(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_7(FUNC, __VA_ARGS__)
 #define MC_MAP_IMPL_9(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_8(FUNC, __VA_ARGS__)
 #define MC_MAP_IMPL_10(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_9(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_11(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_10(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_12(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_11(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_13(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_12(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_14(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_13(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_15(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_14(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_16(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_15(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_17(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_16(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_18(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_17(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_19(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_18(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_20(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_19(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_21(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_20(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_22(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_21(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_23(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_22(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_24(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_23(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_25(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_24(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_26(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_25(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_27(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_26(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_28(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_27(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_29(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_28(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_30(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_29(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_31(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_30(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_32(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_31(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_33(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_32(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_34(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_33(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_35(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_34(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_36(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_35(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_37(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_36(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_38(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_37(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_39(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_38(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_40(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_39(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_41(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_40(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_42(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_41(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_43(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_42(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_44(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_43(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_45(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_44(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_46(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_45(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_47(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_46(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_48(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_47(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_49(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_48(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_50(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_49(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_51(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_50(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_52(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_51(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_53(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_52(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_54(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_53(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_55(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_54(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_56(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_55(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_57(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_56(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_58(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_57(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_59(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_58(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_60(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_59(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_61(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_60(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_62(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_61(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_63(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_62(FUNC, __VA_ARGS__)
+#define MC_MAP_IMPL_64(FUNC, x, ...) FUNC(x), MC_MAP_IMPL_63(FUNC, __VA_ARGS__)
+
+// FUNC(ARG, x) for each argument, without separators.
+#define MC_FOR_EACH(FUNC, ARG, ...) \
+    MC_INDIRECT_EXPAND(MC_FOR_EACH_IMPL, (MC_COUNT_ARGS(__VA_ARGS__), FUNC, ARG, __VA_ARGS__))
+#define MC_FOR_EACH_IMPL(N, FUNC, ARG, ...) MC_FOR_EACH_IMPL_##N(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_1(FUNC, ARG, x) FUNC(ARG, x)
+#define MC_FOR_EACH_IMPL_2(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_1(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_3(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_2(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_4(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_3(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_5(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_4(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_6(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_5(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_7(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_6(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_8(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_7(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_9(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_8(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_10(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_9(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_11(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_10(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_12(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_11(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_13(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_12(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_14(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_13(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_15(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_14(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_16(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_15(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_17(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_16(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_18(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_17(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_19(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_18(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_20(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_19(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_21(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_20(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_22(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_21(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_23(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_22(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_24(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_23(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_25(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_24(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_26(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_25(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_27(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_26(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_28(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_27(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_29(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_28(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_30(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_29(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_31(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_30(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_32(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_31(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_33(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_32(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_34(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_33(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_35(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_34(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_36(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_35(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_37(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_36(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_38(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_37(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_39(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_38(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_40(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_39(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_41(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_40(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_42(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_41(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_43(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_42(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_44(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_43(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_45(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_44(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_46(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_45(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_47(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_46(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_48(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_47(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_49(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_48(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_50(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_49(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_51(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_50(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_52(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_51(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_53(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_52(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_54(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_53(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_55(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_54(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_56(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_55(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_57(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_56(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_58(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_57(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_59(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_58(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_60(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_59(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_61(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_60(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_62(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_61(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_63(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_62(FUNC, ARG, __VA_ARGS__)
+#define MC_FOR_EACH_IMPL_64(FUNC, ARG, x, ...) FUNC(ARG, x) MC_FOR_EACH_IMPL_63(FUNC, ARG, __VA_ARGS__)
 
 // --- Extraction Helpers ---
-#define MC_NODE(field, driver) (field, driver)
-#define MC_EXTRACT_DRIVER(node) MC_GET_DRIVER node
-#define MC_EXTRACT_OFFSET(node) MC_GET_OFFSET node
+#define MC_NODE(field, driver) (field, driver, NULL, 0)
+// Child defined with MC_DEFINE_COMPOSITE_DRIVER, flattened into the parent.
+#define MC_COMPOSITE_NODE(field, NAME) (field, &NAME, &NAME##_composite, 1)
+#define MC_EXTRACT_DRIVER(T, node) MC_GET_DRIVER node,
+#define MC_EXTRACT_OFFSET(T, node) offsetof(T, MC_GET_FIELD node),
+#define MC_EXTRACT_NESTED(T, node) MC_GET_NESTED node,
+#define MC_EXTRACT_IS_NESTED(T, node) +MC_GET_IS_NESTED node
+
+// Internal helpers to unpack (field, driver, nested, is_nested)
+#define MC_GET_FIELD(field, driver, nested, is_nested) field
+#define MC_GET_DRIVER(field, driver, nested, is_nested) driver
+#define MC_GET_NESTED(field, driver, nested, is_nested) nested
+#define MC_GET_IS_NESTED(field, driver, nested, is_nested) is_nested
 
-// Internal helpers to unpack (field, driver)
-#define MC_GET_DRIVER(field, driver) driver
-#define MC_GET_OFFSET(field, driver) offsetof(CTX_TYPE, field)
+// Leaf table size
+#define MC_COMPOSITE_LEAF_CAPACITY(...)                        \
+    ((0 MC_FOR_EACH(MC_EXTRACT_IS_NESTED, _, __VA_ARGS__)) > 0 \
+         ? MC_COMPOSITE_MAX_LEAVES                             \
+         : MC_COUNT_ARGS(__VA_ARGS__))
+
+// Declare a composite driver defined in another file, e.g. to nest it.
+#define MC_DECLARE_COMPOSITE_DRIVER(NAME) \
+    extern const mc_system_driver_t NAME; \
+    extern const mc_composite_driver_t NAME##_composite
 
 // --- THE MAIN MACRO ---
 // Usage: MC_DEFINE_COMPOSITE(blinker_driver, blinker_ctx_t, MC_NODE(pwm, &pwm_drv), ...)
-#define MC_DEFINE_COMPOSITE_DRIVER(NAME, CTX_TYPE_ARG, ...)                           \
-    /* 1. Define Internal Context Type for Offset Calculation */                      \
-    typedef CTX_TYPE_ARG NAME##_CTX_TYPE;                                             \
-    typedef CTX_TYPE_ARG CTX_TYPE; /* Shadow for macros */                            \
-                                                                                      \
-    /* 2. Generate Systems Array (Flash) */                                           \
-    static const mc_system_driver_t *const NAME##_systems[] = {                       \
-        MC_MAP(MC_EXTRACT_DRIVER, __VA_ARGS__)};                                      \
-                                                                                      \
-    /* 3. Generate Offsets Array (Flash) */                                           \
-    static const size_t NAME##_offsets[] = {                                          \
-        MC_MAP(MC_EXTRACT_OFFSET, __VA_ARGS__)};                                      \
-                                                                                      \
-    /* 4. Generate Driver (Flash) */                                                  \
-    static const mc_composite_driver_t NAME##_driver = {                              \
-        .count = sizeof(NAME##_systems) / sizeof(NAME##_systems[0]),                  \
-        .systems = NAME##_systems,                                                    \
-        .ctx_offsets = NAME##_offsets};                                               \
-                                                                                      \
-    /* 5. Generate Trampoline Functions (Flash) */                                    \
-    /* These inject the driver pointer into the generic impl functions */             \
-    static void NAME##_init(void *ctx)                                                \
-    {                                                                                 \
-        mc_composite_init(ctx, &NAME##_driver);                                       \
-    }                                                                                 \
-    static mc_status_t NAME##_write_input(void *ctx, uint8_t id, int32_t val)         \
-    {                                                                                 \
-        return mc_composite_write_input(ctx, &NAME##_driver, id, val);                \
-    }                                                                                 \
-    static mc_result_t NAME##_read_input(void *ctx, uint8_t id)                       \
-    {                                                                                 \
-        return mc_composite_read_input(ctx, &NAME##_driver, id);                      \
-    }                                                                                 \
-    static mc_result_t NAME##_read_output(void *ctx, uint8_t id)                      \
-    {                                                                                 \
-        return mc_composite_read_output(ctx, &NAME##_driver, id);                     \
-    }                                                                                 \
-    static mc_status_t NAME##_invoke(void *ctx, uint8_t id, int32_t *args, uint8_t c) \
-    {                                                                                 \
-        return mc_composite_invoke(ctx, &NAME##_driver, id, args, c);                 \
-    }                                                                                 \
-    static mc_status_t NAME##_get_alias(void *ctx, uint8_t id,                        \
-                                        mc_sys_cmd_info_t *info)                      \
-    {                                                                                 \
-        return mc_composite_get_alias(ctx, &NAME##_driver, id, info);                 \
-    }                                                                                 \
-    static uint8_t NAME##_get_input_count(void *ctx)                                  \
-    {                                                                                 \
-        return mc_composite_get_input_count(ctx, &NAME##_driver);                     \
-    }                                                                                 \
-    static uint8_t NAME##_get_output_count(void *ctx)                                 \
-    {                                                                                 \
-        return mc_composite_get_output_count(ctx, &NAME##_driver);                    \
-    }                                                                                 \
-    static uint8_t NAME##_get_function_count(void *ctx)                               \
-    {                                                                                 \
-        return mc_composite_get_function_count(ctx, &NAME##_driver);                  \
-    }                                                                                 \
-    static uint8_t NAME##_get_alias_count(void *ctx)                                  \
-    {                                                                                 \
-        return mc_composite_get_alias_count(ctx, &NAME##_driver);                     \
-    }                                                                                 \
-                                                                                      \
-    /* 6. Define The Driver (Flash) */                                                \
-    const mc_system_driver_t NAME = {                                                 \
-        .init = NAME##_init,                                                          \
-        .invoke = NAME##_invoke,                                                      \
-        .write_input = NAME##_write_input,                                            \
-        .read_input = NAME##_read_input,                                              \
-        .read_output = NAME##_read_output,                                            \
-        .get_alias = NAME##_get_alias,                                                \
-        .get_function_count = NAME##_get_function_count,                              \
-        .get_input_count = NAME##_get_input_count,                                    \
-        .get_output_count = NAME##_get_output_count,                                  \
-        .get_alias_count = NAME##_get_alias_count};
+// Up to 64 children. Children may be composites themselves (MC_COMPOSITE_NODE).
+#define MC_DEFINE_COMPOSITE_DRIVER(NAME, CTX_TYPE_ARG, ...)                   \
+    MC_DEFINE_COMPOSITE_DRIVER_WITH_INSTANCES(NAME, CTX_TYPE_ARG,             \
+                                              MC_COMPOSITE_DEFAULT_INSTANCES, \
+                                              __VA_ARGS__)
+
+// Same as above, with a member table for each of INSTANCES instances.
+// Instances take a table on init or first use, and keep it.
+#define MC_DEFINE_COMPOSITE_DRIVER_WITH_INSTANCES(NAME, CTX_TYPE_ARG, INSTANCES, ...)    \
+    /* 1. Define Internal Context Type */                                                \
+    typedef CTX_TYPE_ARG NAME##_CTX_TYPE;                                                \
+                                                                                         \
+    /* 2. Generate Systems Array (Flash) */                                              \
+    static const mc_system_driver_t *const NAME##_systems[] = {                          \
+        MC_FOR_EACH(MC_EXTRACT_DRIVER, NAME##_CTX_TYPE, __VA_ARGS__)};                   \
+                                                                                         \
+    /* 3. Generate Offsets and Nested Composites Arrays (Flash) */                       \
+    static const size_t NAME##_offsets[] = {                                             \
+        MC_FOR_EACH(MC_EXTRACT_OFFSET, NAME##_CTX_TYPE, __VA_ARGS__)};                   \
+    static const mc_composite_driver_t *const NAME##_nested[] = {                        \
+        MC_FOR_EACH(MC_EXTRACT_NESTED, NAME##_CTX_TYPE, __VA_ARGS__)};                   \
+                                                                                         \
+    /* 4. Generate Leaf Table Caches (RAM) */                                            \
+    static mc_composite_leaf_t                                                           \
+        NAME##_leaves[MC_COMPOSITE_LEAF_CAPACITY(__VA_ARGS__)];                          \
+    static mc_composite_prefix_t                                                         \
+        NAME##_prefix[(INSTANCES) * (MC_COMPOSITE_LEAF_CAPACITY(__VA_ARGS__) + 1)];      \
+    static mc_composite_cache_t NAME##_caches[INSTANCES];                                \
+                                                                                         \
+    /* 5. Generate Driver (Flash) */                                                     \
+    const mc_composite_driver_t NAME##_composite = {                                     \
+        .count = sizeof(NAME##_systems) / sizeof(NAME##_systems[0]),                     \
+        .systems = NAME##_systems,                                                       \
+        .ctx_offsets = NAME##_offsets,                                                   \
+        .nested = NAME##_nested,                                                         \
+        .caches = NAME##_caches,                                                         \
+        .cache_count = INSTANCES,                                                        \
+        .leaves = NAME##_leaves,                                                         \
+        .prefix = NAME##_prefix,                                                         \
+        .capacity = MC_COMPOSITE_LEAF_CAPACITY(__VA_ARGS__)};                            \
+                                                                                         \
+    /* 6. Generate Trampoline Functions (Flash) */                                       \
+    /* These inject the driver pointer into the generic impl functions */                \
+    static void NAME##_init(void *ctx)                                                   \
+    {                                                                                    \
+        mc_composite_init(ctx, &NAME##_composite);                                       \
+    }                                                                                    \
+    static mc_status_t NAME##_write_input(void *ctx, mc_sys_id_t id, int32_t val)        \
+    {                                                                                    \
+        return mc_composite_write_input(ctx, &NAME##_composite, id, val);                \
+    }                                                                                    \
+    static mc_result_t NAME##_read_input(void *ctx, mc_sys_id_t id)                      \
+    {                                                                                    \
+        return mc_composite_read_input(ctx, &NAME##_composite, id);                      \
+    }                                                                                    \
+    static mc_result_t NAME##_read_output(void *ctx, mc_sys_id_t id)                     \
+    {                                                                                    \
+        return mc_composite_read_output(ctx, &NAME##_composite, id);                     \
+    }                                                                                    \
+    static mc_status_t NAME##_read_outputs(void *ctx, mc_sys_id_t id, mc_sys_id_t c,     \
+                                           int32_t *values, mc_status_t *errors)         \
+    {                                                                                    \
+        return mc_composite_read_outputs(ctx, &NAME##_composite, id, c, values, errors); \
+    }                                                                                    \
+    static mc_status_t NAME##_write_inputs(void *ctx, mc_sys_id_t id, mc_sys_id_t c,     \
+                                           const int32_t *values,                        \
+                                           mc_status_t *errors)                          \
+    {                                                                                    \
+        return mc_composite_write_inputs(ctx, &NAME##_composite, id, c, values, errors); \
+    }                                                                                    \
+    static mc_status_t NAME##_commit_inputs(void *ctx, mc_sys_id_t c,                    \
+                                            const mc_sys_id_t *ids,                      \
+                                            const int32_t *values,                       \
+                                            mc_status_t *errors)                         \
+    {                                                                                    \
+        return mc_composite_commit_inputs(ctx, &NAME##_composite, c, ids, values,        \
+                                          errors);                                       \
+    }                                                                                    \
+    static mc_status_t NAME##_update(void *ctx, uint32_t dt_ms)                          \
+    {                                                                                    \
+        return mc_composite_update(ctx, &NAME##_composite, dt_ms);                       \
+    }                                                                                    \
+    static bool NAME##_has_update(void *ctx)                                             \
+    {                                                                                    \
+        return mc_composite_has_update(ctx, &NAME##_composite);                          \
+    }                                                                                    \
+    static bool NAME##_counts_changed(void *ctx)                                         \
+    {                                                                                    \
+        return mc_composite_counts_changed(ctx, &NAME##_composite);                      \
+    }                                                                                    \
+    static void NAME##_invalidate(void *ctx)                                             \
+    {                                                                                    \
+        mc_composite_invalidate(ctx, &NAME##_composite);                                 \
+    }                                                                                    \
+    static mc_status_t NAME##_invoke(void *ctx, mc_sys_id_t id, int32_t *args,           \
+                                     uint8_t c)                                          \
+    {                                                                                    \
+        return mc_composite_invoke(ctx, &NAME##_composite, id, args, c);                 \
+    }                                                                                    \
+    static mc_status_t NAME##_get_alias(void *ctx, mc_sys_id_t id,                       \
+                                        mc_sys_cmd_info_t *info)                         \
+    {                                                                                    \
+        return mc_composite_get_alias(ctx, &NAME##_composite, id, info);                 \
+    }                                                                                    \
+    static mc_sys_id_t NAME##_get_input_count(void *ctx)                                 \
+    {                                                                                    \
+        return mc_composite_get_input_count(ctx, &NAME##_composite);                     \
+    }                                                                                    \
+    static mc_sys_id_t NAME##_get_output_count(void *ctx)                                \
+    {                                                                                    \
+        return mc_composite_get_output_count(ctx, &NAME##_composite);                    \
+    }                                                                                    \
+    static mc_sys_id_t NAME##_get_function_count(void *ctx)                              \
+    {                                                                                    \
+        return mc_composite_get_function_count(ctx, &NAME##_composite);                  \
+    }                                                                                    \
+    static mc_sys_id_t NAME##_get_alias_count(void *ctx)                                 \
+    {                                                                                    \
+        return mc_composite_get_alias_count(ctx, &NAME##_composite);                     \
+    }                                                                                    \
+                                                                                         \
+    /* 7. Define The Driver (Flash) */                                                   \
+    const mc_system_driver_t NAME = {                                                    \
+        .init = NAME##_init,                                                             \
+        .invoke = NAME##_invoke,                                                         \
+        .write_input = NAME##_write_input,                                               \
+        .read_input = NAME##_read_input,                                                 \
+        .read_output = NAME##_read_output,                                               \
+        .get_alias = NAME##_get_alias,                                                   \
+        .get_function_count = NAME##_get_function_count,                                 \
+        .get_input_count = NAME##_get_input_count,                                       \
+        .get_output_count = NAME##_get_output_count,                                     \
+        .get_alias_count = NAME##_get_alias_count,                                       \
+        .read_outputs = NAME##_read_outputs,                                             \
+        .write_inputs = NAME##_write_inputs,                                             \
+        .commit_inputs = NAME##_commit_inputs,                                           \
+        .update = NAME##_update,                                                         \
+        .has_update = NAME##_has_update,                                                 \
+        .counts_changed = NAME##_counts_changed,                                         \
+        .invalidate = NAME##_invalidate};
 
 #ifdef __cplusplus
 }
@@ -12,35 +12,96 @@ extern "C"
 // Defaults
 #define SYS_CONSOLE_DEFAULT_HEADER_COUNT 5
 #define SYS_CONSOLE_DEFAULT_ARGS_COUNT 8
+#define SYS_CONSOLE_DEFAULT_ALIAS_COUNT 16
+
+// Index lengths for COUNT aliases or systems. Keep load factor at 50%.
+#define MC_SYS_CONSOLE_ALIAS_INDEX_LEN(COUNT) ((COUNT) * 2)
+#define MC_SYS_CONSOLE_NAME_INDEX_LEN(COUNT) ((COUNT) * 2)
 
 // Macros for cleaner definitions
 #define MC_SYS_ENTRY(ID, SYS, NAME) {.id = ID, .system = &SYS, .name = NAME}
 
 #define MC_DEFINE_SYSTEM_CONSOLE(NAME, STREAM, SYSTEMS, SYS_COUNT, ARGS_COUNT, \
                                  HEADER_COUNT)                                 \
-    static int32_t NAME##_args[ARGS_COUNT];                                    \
-    static const mc_system_console_config_t NAME##_config =                    \
-        {                                                                      \
-            .systems = SYSTEMS,                                                \
-            .system_count = SYS_COUNT,                                         \
-            .args_buffer = NAME##_args,                                        \
-            .args_count = ARGS_COUNT,                                          \
-            .header_count = HEADER_COUNT};                                     \
-    static mc_system_console_state_t NAME##_state = {0};                       \
-    static const mc_system_console_t NAME =                                    \
-        {                                                                      \
-            .stream = &STREAM,                                                 \
-            .config = &NAME##_config,                                          \
+    MC_DEFINE_SYSTEM_CONSOLE_WITH_ALIASES(NAME, STREAM, SYSTEMS, SYS_COUNT,    \
+                                          ARGS_COUNT, HEADER_COUNT,            \
+                                          SYS_CONSOLE_DEFAULT_ALIAS_COUNT)
+
+// Same as above, with room for ALIAS_COUNT aliases (of all systems together)
+// in the alias index. Aliases that do not fit are still found, by a linear
+// search.
+#define MC_DEFINE_SYSTEM_CONSOLE_WITH_ALIASES(NAME, STREAM, SYSTEMS, SYS_COUNT, \
+                                              ARGS_COUNT, HEADER_COUNT,         \
+                                              ALIAS_COUNT)                      \
+    static mc_sys_console_name_slot_t                                           \
+        NAME##_name_index[MC_SYS_CONSOLE_NAME_INDEX_LEN(SYS_COUNT)];            \
+    MC_SYS_CONSOLE_DEFINE(NAME, STREAM, SYSTEMS, SYS_COUNT, NULL,               \
+                          NAME##_name_index,                                    \
+                          MC_SYS_CONSOLE_NAME_INDEX_LEN(SYS_COUNT), ARGS_COUNT, \
+                          HEADER_COUNT, ALIAS_COUNT)
+
+// Console for the systems of a registry from MC_DEFINE_SYSTEM_REGISTRY, in the
+// same source file. System names and IDs are resolved through the registry,
+// which must be initialized before the first command. Names are found by the
+// registry's binary search over name hashes, not by a console name index.
+#define MC_DEFINE_SYSTEM_CONSOLE_WITH_REGISTRY(NAME, STREAM, REGISTRY,       \
+                                               ARGS_COUNT, HEADER_COUNT)     \
+    MC_SYS_CONSOLE_DEFINE(NAME, STREAM, REGISTRY##_entries, MC_SYS_ID_COUNT, \
+                          &REGISTRY, NULL, 0, ARGS_COUNT, HEADER_COUNT,      \
+                          SYS_CONSOLE_DEFAULT_ALIAS_COUNT)
+
+#define MC_SYS_CONSOLE_DEFINE(NAME, STREAM, SYSTEMS, SYS_COUNT, REGISTRY,   \
+                              NAME_INDEX, NAME_INDEX_LEN, ARGS_COUNT,       \
+                              HEADER_COUNT, ALIAS_COUNT)                    \
+    static int32_t NAME##_args[ARGS_COUNT];                                 \
+    static mc_sys_console_alias_slot_t                                      \
+        NAME##_alias_index[MC_SYS_CONSOLE_ALIAS_INDEX_LEN(ALIAS_COUNT)];    \
+    static const mc_system_console_config_t NAME##_config =                 \
+        {                                                                   \
+            .systems = SYSTEMS,                                             \
+            .system_count = SYS_COUNT,                                      \
+            .registry = REGISTRY,                                           \
+            .args_buffer = NAME##_args,                                     \
+            .args_count = ARGS_COUNT,                                       \
+            .header_count = HEADER_COUNT,                                   \
+            .alias_index = NAME##_alias_index,                              \
+            .alias_index_len = MC_SYS_CONSOLE_ALIAS_INDEX_LEN(ALIAS_COUNT), \
+            .name_index = NAME_INDEX,                                       \
+            .name_index_len = NAME_INDEX_LEN};                              \
+    static mc_system_console_state_t NAME##_state = {0};                    \
+    static const mc_system_console_t NAME =                                 \
+        {                                                                   \
+            .stream = &STREAM,                                              \
+            .config = &NAME##_config,                                       \
             .state = &NAME##_state}
 
+    // Defined in mc/system/registry.h.
+    struct mc_sys_registry_t;
+
     // Struct for each system.
     typedef struct mc_system_entry_t
     {
-        const uint8_t id;
+        const mc_sys_id_t id;
         const mc_system_t *system;
         const char *name;
     } mc_system_entry_t;
 
+    // Alias index slot. sys is the system index + 1, 0 means empty.
+    typedef struct mc_sys_console_alias_slot_t
+    {
+        uint16_t tag; // High half of the alias hash
+        uint8_t sys;
+        mc_sys_id_t id;
+    } mc_sys_console_alias_slot_t;
+
+    // System name index slot. sys is the system index + 1, 0 means empty.
+    typedef struct mc_sys_console_name_slot_t
+    {
+        uint16_t tag; // High half of the name hash
+        uint8_t len;
+        uint8_t sys;
+    } mc_sys_console_name_slot_t;
+
     // Struct for console config
     typedef struct mc_system_console_config_t
     {
@@ -48,18 +109,35 @@ extern "C"
         const mc_system_entry_t *systems;
         uint8_t system_count;
 
+        // Registry the systems come from, or NULL. If set, names and IDs are
+        // looked up through it.
+        const struct mc_sys_registry_t *registry;
+
         // Argument buffer used to parse function arguments.
         int32_t *args_buffer;
         uint8_t args_count;
 
         // Max header count when dumping
         uint8_t header_count;
+
+        // Open addressing index of the aliases of all systems.
+        mc_sys_console_alias_slot_t *alias_index;
+        uint16_t alias_index_len;
+
+        // Open addressing index of system names, built at init. Unused with
+        // a registry.
+        mc_sys_console_name_slot_t *name_index;
+        uint16_t name_index_len;
     } mc_system_console_config_t;
 
     // Struct for console state
     typedef struct mc_system_console_state_t
     {
         mc_callback_t rx_callback;
+        // Generation the alias index was built at, see mc_sys_get_generation.
+        uint32_t alias_generation;
+        bool is_alias_index_valid;
+        bool is_alias_index_complete; // Every alias fit
         uint8_t is_initialized;
     } mc_system_console_state_t;
 
@@ -80,6 +158,11 @@ extern "C"
                                     const mc_system_entry_t *systems,
                                     uint8_t sys_count);
 
+#if MC_EVENT_PROFILING
+    /* Dump trigger counts and callback timing of profiled events. */
+    mc_status_t mc_sys_console_dump_profile(const mc_system_console_t *console);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
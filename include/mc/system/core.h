@@ -5,8 +5,27 @@ extern "C"
 {
 #endif
 
+#include "mc/list.h"
 #include "mc/status.h"
 
+#include <stdint.h>
+
+// Set to 1 for 16-bit member IDs, for systems (mostly composites) with more
+// than 255 functions, inputs, outputs or aliases. Costs a byte per ID.
+#ifndef MC_SYS_WIDE_IDS
+#define MC_SYS_WIDE_IDS 0
+#endif
+
+#if MC_SYS_WIDE_IDS
+    /* Member ID and member count type. */
+    typedef uint16_t mc_sys_id_t;
+#define MC_SYS_MAX_ID UINT16_MAX
+#else
+    /* Member ID and member count type. */
+    typedef uint8_t mc_sys_id_t;
+#define MC_SYS_MAX_ID UINT8_MAX
+#endif
+
 // Macro for defining a system. Users should always use this.
 #define MC_DEFINE_SYSTEM(NAME, DRIVER, CTX)      \
     static mc_system_state_t NAME##_state = {0}; \
@@ -16,6 +35,15 @@ extern "C"
         .ctx = (void *)(&CTX),                   \
         .state = &NAME##_state};
 
+// Capability flags, cached in mc_system_state_t. Set if the driver has the
+// operation and the member count it is bounds checked against.
+#define MC_SYS_CAP_INVOKE (1U << 0)
+#define MC_SYS_CAP_WRITE_INPUT (1U << 1)
+#define MC_SYS_CAP_READ_INPUT (1U << 2)
+#define MC_SYS_CAP_READ_OUTPUT (1U << 3)
+#define MC_SYS_CAP_GET_ALIAS (1U << 4)
+#define MC_SYS_CAP_UPDATE (1U << 5)
+
     // Enum of different command types
     typedef enum mc_sys_cmd_type_t
     {
@@ -30,7 +58,7 @@ extern "C"
     {
         const char *alias;
         mc_sys_cmd_type_t type;
-        uint8_t id;
+        mc_sys_id_t id;
         bool has_preset;    // If true, use the value below.
         int32_t preset_val; // e.g. 1 (for turnOn)
     } mc_sys_cmd_info_t;
@@ -42,32 +70,82 @@ extern "C"
         void (*init)(void *ctx);
 
         // For invoking functions.
-        mc_status_t (*invoke)(void *ctx, uint8_t func_id, int32_t *args,
+        mc_status_t (*invoke)(void *ctx, mc_sys_id_t func_id, int32_t *args,
                               uint8_t arg_count);
 
         // Write value to input.
-        mc_status_t (*write_input)(void *ctx, uint8_t x_id, int32_t val);
+        mc_status_t (*write_input)(void *ctx, mc_sys_id_t x_id, int32_t val);
 
         // Read input value.
-        mc_result_t (*read_input)(void *ctx, uint8_t x_id);
+        mc_result_t (*read_input)(void *ctx, mc_sys_id_t x_id);
 
         // Read output value.
-        mc_result_t (*read_output)(void *ctx, uint8_t y_id);
+        mc_result_t (*read_output)(void *ctx, mc_sys_id_t y_id);
 
         // Get alias command info.
-        mc_status_t (*get_alias)(void *ctx, uint8_t id, mc_sys_cmd_info_t *info);
+        mc_status_t (*get_alias)(void *ctx, mc_sys_id_t id,
+                                 mc_sys_cmd_info_t *info);
 
         // Member counts
-        uint8_t (*get_function_count)(void *ctx);
-        uint8_t (*get_input_count)(void *ctx);
-        uint8_t (*get_output_count)(void *ctx);
-        uint8_t (*get_alias_count)(void *ctx);
+        mc_sys_id_t (*get_function_count)(void *ctx);
+        mc_sys_id_t (*get_input_count)(void *ctx);
+        mc_sys_id_t (*get_output_count)(void *ctx);
+        mc_sys_id_t (*get_alias_count)(void *ctx);
+
+        // Optional. Read count outputs starting at first_id. Returns the first
+        // error, errors (may be NULL) gets the status of each output.
+        mc_status_t (*read_outputs)(void *ctx, mc_sys_id_t first_id,
+                                    mc_sys_id_t count, int32_t *values,
+                                    mc_status_t *errors);
+
+        // Optional. Write count inputs starting at first_id. Returns the first
+        // error, errors (may be NULL) gets the status of each input.
+        mc_status_t (*write_inputs)(void *ctx, mc_sys_id_t first_id,
+                                    mc_sys_id_t count, const int32_t *values,
+                                    mc_status_t *errors);
+
+        // Optional. Write count inputs given by x_ids in one go, e.g. as one
+        // bus transaction. Returns the first error, errors (may be NULL) gets
+        // the status of each input.
+        mc_status_t (*commit_inputs)(void *ctx, mc_sys_id_t count,
+                                     const mc_sys_id_t *x_ids,
+                                     const int32_t *values,
+                                     mc_status_t *errors);
+
+        // Optional. Periodic work, e.g. running a control loop. dt_ms is the
+        // time since the previous update.
+        mc_status_t (*update)(void *ctx, uint32_t dt_ms);
+
+        // Optional. Whether update has work to do for ctx, e.g. a composite
+        // with no child that updates. Checked with the cached counts.
+        bool (*has_update)(void *ctx);
+
+        // Optional. Whether member counts changed since the driver last
+        // reported them, for counts that follow state outside the system,
+        // like a device's read-only flag. Checked on every access.
+        bool (*counts_changed)(void *ctx);
+
+        // Optional. Drop counts the driver caches for ctx. Called by
+        // mc_sys_invalidate.
+        void (*invalidate)(void *ctx);
     } mc_system_driver_t;
 
-    /* System state. */
+    /* System state. Member counts and capabilities are cached from the driver
+     * and refreshed after mc_sys_invalidate of this system, after
+     * mc_sys_invalidate_all, or when the driver reports changed counts. */
     typedef struct mc_system_state_t
     {
+        uint32_t generation;
+        bool is_stale;
+        mc_sys_id_t function_count;
+        mc_sys_id_t input_count;
+        mc_sys_id_t output_count;
+        mc_sys_id_t alias_count;
+        uint8_t capabilities;
         uint8_t is_initialized;
+        // Output subscriptions, see mc/system/subscription.h. Kept across
+        // mc_sys_init.
+        mc_list_t subscriptions;
     } mc_system_state_t;
 
     /* System struct. */
@@ -81,35 +159,99 @@ extern "C"
     /* Initialize system. */
     void mc_sys_init(const mc_system_t *sys);
 
+    /* Mark cached counts of a system stale. Call when its driver's member
+     * counts change without counts_changed reporting it. Other systems keep
+     * their caches. */
+    void mc_sys_invalidate(const mc_system_t *sys);
+
+    /* Mark cached counts of all systems stale. */
+    void mc_sys_invalidate_all(void);
+
+    /* Get cache generation. Changes on mc_sys_invalidate_all, for drivers
+     * that cache counts of their own. */
+    uint32_t mc_sys_get_generation(void);
+
+    /* Get capability flags (MC_SYS_CAP_*). */
+    uint8_t mc_sys_get_capabilities(const mc_system_t *sys);
+
     /* Call a function. */
-    mc_status_t mc_sys_invoke(const mc_system_t *sys, uint8_t func_id,
+    mc_status_t mc_sys_invoke(const mc_system_t *sys, mc_sys_id_t func_id,
                               int32_t *args, uint8_t arg_count);
 
     /* Write an input. */
-    mc_status_t mc_sys_write_input(const mc_system_t *sys, uint8_t x_id,
+    mc_status_t mc_sys_write_input(const mc_system_t *sys, mc_sys_id_t x_id,
                                    int32_t val);
 
     /* Read an input. */
-    mc_result_t mc_sys_read_input(const mc_system_t *sys, uint8_t x_id);
+    mc_result_t mc_sys_read_input(const mc_system_t *sys, mc_sys_id_t x_id);
 
     /* Read an output. */
-    mc_result_t mc_sys_read_output(const mc_system_t *sys, uint8_t y_id);
+    mc_result_t mc_sys_read_output(const mc_system_t *sys, mc_sys_id_t y_id);
+
+    /* Run periodic update of system. */
+    mc_status_t mc_sys_update(const mc_system_t *sys, uint32_t dt_ms);
+
+    /* Read count outputs starting at first_id in one call. Returns the first
+     * error. out_errors (may be NULL) gets what mc_sys_read_output would
+     * return for each output; values of failed outputs are left untouched. */
+    mc_status_t mc_sys_read_outputs(const mc_system_t *sys,
+                                    mc_sys_id_t first_id, mc_sys_id_t count,
+                                    int32_t *out_values,
+                                    mc_status_t *out_errors);
+
+    /* Write count inputs starting at first_id in one call. Returns the first
+     * error. out_errors (may be NULL) gets the status of each input. */
+    mc_status_t mc_sys_write_inputs(const mc_system_t *sys,
+                                    mc_sys_id_t first_id, mc_sys_id_t count,
+                                    const int32_t *values,
+                                    mc_status_t *out_errors);
+
+    /* Write inputs given by x_ids in one call, see mc/system/transaction.h.
+     * Returns the first error. out_errors (may be NULL) gets the status of
+     * each input. */
+    mc_status_t mc_sys_commit_inputs(const mc_system_t *sys, mc_sys_id_t count,
+                                     const mc_sys_id_t *x_ids,
+                                     const int32_t *values,
+                                     mc_status_t *out_errors);
+
+    /* Read outputs straight through driver ops, without bounds checks. Uses
+     * read_outputs if the driver has it, otherwise read_output per output.
+     * For drivers wrapping other drivers. */
+    mc_status_t mc_sys_driver_read_outputs(const mc_system_driver_t *driver,
+                                           void *ctx, mc_sys_id_t first_id,
+                                           mc_sys_id_t count, int32_t *values,
+                                           mc_status_t *errors);
+
+    /* Write inputs straight through driver ops, without bounds checks. */
+    mc_status_t mc_sys_driver_write_inputs(const mc_system_driver_t *driver,
+                                           void *ctx, mc_sys_id_t first_id,
+                                           mc_sys_id_t count,
+                                           const int32_t *values,
+                                           mc_status_t *errors);
+
+    /* Commit inputs straight through driver ops, without bounds checks. Uses
+     * commit_inputs if the driver has it, otherwise write_input per input. */
+    mc_status_t mc_sys_driver_commit_inputs(const mc_system_driver_t *driver,
+                                            void *ctx, mc_sys_id_t count,
+                                            const mc_sys_id_t *x_ids,
+                                            const int32_t *values,
+                                            mc_status_t *errors);
 
     /* Get an alias. */
-    mc_status_t mc_sys_get_alias(const mc_system_t *sys, uint8_t id,
+    mc_status_t mc_sys_get_alias(const mc_system_t *sys, mc_sys_id_t id,
                                  mc_sys_cmd_info_t *info);
 
     /* Get function count */
-    uint8_t mc_sys_get_function_count(const mc_system_t *sys);
+    mc_sys_id_t mc_sys_get_function_count(const mc_system_t *sys);
 
     /* Get input count */
-    uint8_t mc_sys_get_input_count(const mc_system_t *sys);
+    mc_sys_id_t mc_sys_get_input_count(const mc_system_t *sys);
 
     /* Get output count */
-    uint8_t mc_sys_get_output_count(const mc_system_t *sys);
+    mc_sys_id_t mc_sys_get_output_count(const mc_system_t *sys);
 
     /* Get alias count */
-    uint8_t mc_sys_get_alias_count(const mc_system_t *sys);
+    mc_sys_id_t mc_sys_get_alias_count(const mc_system_t *sys);
 
 #ifdef __cplusplus
 }
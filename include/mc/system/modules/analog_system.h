@@ -33,6 +33,7 @@ extern "C"
         const mc_analog_t *device;
         const mc_analog_system_config_t *config;
         int32_t target_value;
+        bool is_read_only; // Device read-only state the counts were read with
     } mc_analog_system_ctx_t;
 
     // analog system driver.
@@ -36,6 +36,7 @@ extern "C"
         const mc_digital_t *device;
         const mc_digital_system_config_t *config;
         bool target_state;
+        bool is_read_only; // Device read-only state the counts were read with
     } mc_digital_system_ctx_t;
 
     // Digital system driver.
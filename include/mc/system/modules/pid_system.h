@@ -0,0 +1,91 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "mc/system/core.h"
+#include "mc/device/analog.h"
+
+// Fixed point gains are Q16.16.
+#define MC_PID_Q16_ONE 65536
+#define MC_PID_Q16(x) ((int32_t)((x) * MC_PID_Q16_ONE))
+
+// Config with default names. Gains as real numbers, ki per second and kd in
+// seconds.
+#define MC_PID_SYSTEM_CONFIG(KP, KI, KD, OUTPUT_MIN, OUTPUT_MAX) \
+    {                                                            \
+        .kp = MC_PID_Q16(KP),                                    \
+        .ki = MC_PID_Q16(KI),                                    \
+        .kd = MC_PID_Q16(KD),                                    \
+        .output_min = OUTPUT_MIN,                                \
+        .output_max = OUTPUT_MAX,                                \
+        .value_name = "value",                                   \
+        .output_name = "output",                                 \
+        .setpoint_name = "setpoint",                             \
+        .kp_name = "kp",                                         \
+        .ki_name = "ki",                                         \
+        .kd_name = "kd",                                         \
+        .reset_name = "reset"}
+
+// Macro for defining PID system. Users should always use this.
+#define MC_DEFINE_PID_SYSTEM(NAME, CONFIG, SENSOR, ACTUATOR) \
+    static mc_pid_system_ctx_t NAME##_ctx = {                \
+        .sensor = &SENSOR,                                   \
+        .actuator = &ACTUATOR,                               \
+        .config = &CONFIG};                                  \
+                                                             \
+    MC_DEFINE_SYSTEM(NAME, mc_pid_sys_driver, NAME##_ctx);
+
+    // Config for this system
+    typedef struct mc_pid_system_config_t
+    {
+        // Initial gains, Q16.16
+        int32_t kp;
+        int32_t ki;
+        int32_t kd;
+
+        // Actuator range
+        int32_t output_min;
+        int32_t output_max;
+
+        const char *value_name;
+        const char *output_name;
+        const char *setpoint_name;
+        const char *kp_name;
+        const char *ki_name;
+        const char *kd_name;
+        const char *reset_name;
+    } mc_pid_system_config_t;
+
+    // Context for this system
+    typedef struct mc_pid_system_ctx_t
+    {
+        const mc_analog_t *sensor;
+        const mc_analog_t *actuator;
+        const mc_pid_system_config_t *config;
+        int32_t setpoint;
+        int32_t kp;
+        int32_t ki;
+        int32_t kd;
+        int64_t integral; // Q16.16, in output units
+        int32_t prev_value;
+        int32_t output;
+        bool has_prev_value;
+    } mc_pid_system_ctx_t;
+
+    /**
+     * PID controller driving actuator so sensor reaches setpoint, run by the
+     * update op. Integer math only and constant cost per update. Derivative
+     * acts on the measurement so setpoint steps do not kick the output. The
+     * integral is clamped to the output range and frozen while the output
+     * saturates in the direction of the error (anti-windup).
+     *
+     * x0 setpoint, x1 kp, x2 ki, x3 kd. y0 sensor value, y1 output. f0 reset.
+     */
+    extern const mc_system_driver_t mc_pid_sys_driver;
+
+#ifdef __cplusplus
+}
+#endif
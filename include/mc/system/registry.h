@@ -0,0 +1,93 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "mc/system/console.h"
+#include "mc/system/core.h"
+
+/*
+ * Systems are declared once in an X-macro list, e.g.
+ *
+ *   #define APP_SYSTEMS(X) \
+ *       X(led, led_sys)    \
+ *       X(motor, motor_sys)
+ *
+ *   MC_DECLARE_SYSTEM_IDS(APP_SYSTEMS);              // In a header
+ *   MC_DEFINE_SYSTEM_REGISTRY(registry, APP_SYSTEMS); // In one source file
+ *
+ * IDs are generated in list order as MC_SYS_ID_led, MC_SYS_ID_motor, and the
+ * total as MC_SYS_ID_COUNT. registry_entries is a plain mc_system_entry_t
+ * table for the console, and APP_SYSTEMS(MC_SYS_REGISTRY_POINTER) expands to
+ * the system pointers for MC_DEFINE_SNAPSHOT.
+ */
+
+#define MC_SYS_REGISTRY_ID(NAME, SYS) MC_SYS_ID_##NAME,
+#define MC_SYS_REGISTRY_ENTRY(NAME, SYS) \
+    {.id = MC_SYS_ID_##NAME, .system = &SYS, .name = #NAME},
+#define MC_SYS_REGISTRY_POINTER(NAME, SYS) &SYS,
+
+// Macro for declaring system IDs of a registry list.
+#define MC_DECLARE_SYSTEM_IDS(LIST)              \
+    enum                                         \
+    {                                            \
+        LIST(MC_SYS_REGISTRY_ID) MC_SYS_ID_COUNT \
+    }
+
+// Macro for defining the registry of a list. IDs must be declared first.
+#define MC_DEFINE_SYSTEM_REGISTRY(NAME, LIST)                    \
+    const mc_system_entry_t NAME##_entries[] = {                 \
+        LIST(MC_SYS_REGISTRY_ENTRY)};                            \
+    static mc_sys_registry_name_t NAME##_names[MC_SYS_ID_COUNT]; \
+    static mc_sys_registry_state_t NAME##_state = {0};           \
+    const mc_sys_registry_t NAME = {                             \
+        .entries = NAME##_entries,                               \
+        .count = MC_SYS_ID_COUNT,                                \
+        .names = NAME##_names,                                   \
+        .state = &NAME##_state}
+
+    /* Name index entry, kept sorted by hash. */
+    typedef struct mc_sys_registry_name_t
+    {
+        uint32_t hash;
+        uint8_t len;
+        uint8_t index;
+    } mc_sys_registry_name_t;
+
+    /* Registry state. */
+    typedef struct mc_sys_registry_state_t
+    {
+        uint8_t is_initialized;
+    } mc_sys_registry_state_t;
+
+    /**
+     * Table of all systems of a firmware. Entry i has ID i, so lookup by ID
+     * is a direct index. Lookup by name is a binary search over name hashes
+     * built at init.
+     */
+    typedef struct mc_sys_registry_t
+    {
+        const mc_system_entry_t *entries;
+        uint8_t count;
+        mc_sys_registry_name_t *names;
+        mc_sys_registry_state_t *state;
+    } mc_sys_registry_t;
+
+    /* Initialize registry and build its name index. */
+    void mc_sys_registry_init(const mc_sys_registry_t *reg);
+
+    /* Get system entry by ID. Returns NULL if there is none. */
+    const mc_system_entry_t *mc_sys_registry_get(const mc_sys_registry_t *reg,
+                                                 mc_sys_id_t id);
+
+    /* Find system entry by the first len chars of name. Returns NULL if there
+     * is none. */
+    const mc_system_entry_t *mc_sys_registry_find(const mc_sys_registry_t *reg,
+                                                  const char *name,
+                                                  size_t len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,61 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "mc/list.h"
+#include "mc/system/core.h"
+
+// Macro for defining a task that updates SYS every PERIOD_MS. Users should
+// always use this.
+#define MC_DEFINE_SYS_TASK(NAME, SYS, PERIOD_MS)   \
+    static mc_sys_task_state_t NAME##_state = {0}; \
+    static const mc_sys_task_t NAME = {            \
+        .system = &SYS,                            \
+        .period_ms = PERIOD_MS,                    \
+        .state = &NAME##_state}
+
+    struct mc_sys_task_t;
+
+    /* Task state. */
+    typedef struct mc_sys_task_state_t
+    {
+        mc_node_t node;
+        const struct mc_sys_task_t *task;
+        uint32_t next_ms;
+        uint32_t last_ms;
+        uint32_t overrun_count;
+        uint8_t is_initialized;
+    } mc_sys_task_state_t;
+
+    /**
+     * Calls mc_sys_update of a system at a fixed rate. Deadlines advance by
+     * the period, so the rate does not drift with loop jitter. If the loop
+     * falls more than a period behind, the missed updates are skipped and
+     * counted as overruns.
+     */
+    typedef struct mc_sys_task_t
+    {
+        const mc_system_t *system;
+        uint32_t period_ms;
+        mc_sys_task_state_t *state;
+    } mc_sys_task_t;
+
+    /* Start task. First update runs one period from now. */
+    void mc_sys_task_start(const mc_sys_task_t *task);
+
+    /* Stop task. */
+    void mc_sys_task_stop(const mc_sys_task_t *task);
+
+    /* Run updates of all due tasks. Call from the main loop. Returns number of
+     * updates run. */
+    uint8_t mc_sys_tasks_run(void);
+
+    /* Get number of skipped updates. */
+    uint32_t mc_sys_task_get_overrun_count(const mc_sys_task_t *task);
+
+#ifdef __cplusplus
+}
+#endif
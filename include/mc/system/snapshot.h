@@ -0,0 +1,97 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "mc/system/core.h"
+#include "mc/utils.h"
+
+// Macro for defining a snapshot of the systems passed as pointers, with room
+// for CAPACITY inputs and outputs in total. Users should always use this.
+#define MC_DEFINE_SNAPSHOT(NAME, CAPACITY, ...)                       \
+    static const mc_system_t *const NAME##_systems[] = {__VA_ARGS__}; \
+    static mc_snapshot_layout_t                                       \
+        NAME##_layouts[2 * MC_ARRAY_SIZE(NAME##_systems)];            \
+    static int32_t NAME##_values[2 * (CAPACITY)];                     \
+    static mc_status_t NAME##_errors[2 * (CAPACITY)];                 \
+    static mc_snapshot_state_t NAME##_state = {0};                    \
+    static const mc_snapshot_t NAME = {                               \
+        .systems = NAME##_systems,                                    \
+        .system_count = MC_ARRAY_SIZE(NAME##_systems),                \
+        .capacity = CAPACITY,                                         \
+        .layouts = NAME##_layouts,                                    \
+        .values = NAME##_values,                                      \
+        .errors = NAME##_errors,                                      \
+        .state = &NAME##_state}
+
+    /* Where the members of one system sit in a snapshot buffer. */
+    typedef struct mc_snapshot_layout_t
+    {
+        uint16_t x_first;
+        uint16_t y_first;
+        mc_sys_id_t x_count;
+        mc_sys_id_t y_count;
+    } mc_snapshot_layout_t;
+
+    /* Snapshot state. */
+    typedef struct mc_snapshot_state_t
+    {
+        // Number of published captures. Its lowest bit selects the front
+        // buffer.
+        volatile uint32_t sequence;
+        uint8_t is_initialized;
+    } mc_snapshot_state_t;
+
+    /**
+     * Double-buffered copy of all inputs and outputs of a set of systems.
+     * mc_snapshot_capture fills the back buffer in one pass and then swaps,
+     * so readers always see values from a single capture. Each buffer is a
+     * flat array of values with a parallel array of errors.
+     */
+    typedef struct mc_snapshot_t
+    {
+        const mc_system_t *const *systems;
+        uint8_t system_count;
+        uint16_t capacity;
+        mc_snapshot_layout_t *layouts; // 2 * system_count
+        int32_t *values;               // 2 * capacity
+        mc_status_t *errors;           // 2 * capacity
+        mc_snapshot_state_t *state;
+    } mc_snapshot_t;
+
+    /* Initialize snapshot. Nothing is readable until the first capture. */
+    void mc_snapshot_init(const mc_snapshot_t *snap);
+
+    /* Read all members of all systems into the back buffer and publish it.
+     * Returns MC_ERROR_NO_RESOURCE if systems were left out for lack of
+     * capacity. */
+    mc_status_t mc_snapshot_capture(const mc_snapshot_t *snap);
+
+    /* Get number of published captures. A reader that may be interrupted by
+     * a capture can compare it before and after reading to detect mixing. */
+    uint32_t mc_snapshot_get_sequence(const mc_snapshot_t *snap);
+
+    /* Read a captured input of the system at sys_index. */
+    mc_result_t mc_snapshot_read_input(const mc_snapshot_t *snap,
+                                       uint8_t sys_index, mc_sys_id_t x_id);
+
+    /* Read a captured output of the system at sys_index. */
+    mc_result_t mc_snapshot_read_output(const mc_snapshot_t *snap,
+                                        uint8_t sys_index, mc_sys_id_t y_id);
+
+    /* Get all captured inputs of the system at sys_index. Failed reads are 0. */
+    const int32_t *mc_snapshot_get_inputs(const mc_snapshot_t *snap,
+                                          uint8_t sys_index,
+                                          mc_sys_id_t *out_count);
+
+    /* Get all captured outputs of the system at sys_index. Failed reads are
+     * 0. */
+    const int32_t *mc_snapshot_get_outputs(const mc_snapshot_t *snap,
+                                           uint8_t sys_index,
+                                           mc_sys_id_t *out_count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,295 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "mc/system/composite.h"
+#include "mc/utils.h"
+
+// --- Static Nodes ---
+// Child with constant member counts: functions, inputs, outputs, aliases.
+#define MC_STATIC_NODE(field, driver, F, X, Y, A) (field, driver, F, X, Y, A)
+
+// Internal helpers to unpack (field, driver, F, X, Y, A)
+#define MC_STATIC_NODE_FIELD(node) MC_STATIC_GET_FIELD node
+#define MC_STATIC_NODE_DRIVER(node) MC_STATIC_GET_DRIVER node
+#define MC_STATIC_NODE_F(node) MC_STATIC_GET_F node
+#define MC_STATIC_NODE_X(node) MC_STATIC_GET_X node
+#define MC_STATIC_NODE_Y(node) MC_STATIC_GET_Y node
+#define MC_STATIC_NODE_A(node) MC_STATIC_GET_A node
+#define MC_STATIC_GET_FIELD(field, driver, F, X, Y, A) field
+#define MC_STATIC_GET_DRIVER(field, driver, F, X, Y, A) (driver)
+#define MC_STATIC_GET_F(field, driver, F, X, Y, A) (F)
+#define MC_STATIC_GET_X(field, driver, F, X, Y, A) (X)
+#define MC_STATIC_GET_Y(field, driver, F, X, Y, A) (Y)
+#define MC_STATIC_GET_A(field, driver, F, X, Y, A) (A)
+#define MC_STATIC_CHILD_CTX(T, node) (&((T *)ctx)->MC_STATIC_NODE_FIELD(node))
+
+// --- [Internal] Offset Accumulator (F, X, Y, A) ---
+#define MC_STATIC_ACC_F(acc) MC_STATIC_GET_ACC_F acc
+#define MC_STATIC_ACC_X(acc) MC_STATIC_GET_ACC_X acc
+#define MC_STATIC_ACC_Y(acc) MC_STATIC_GET_ACC_Y acc
+#define MC_STATIC_ACC_A(acc) MC_STATIC_GET_ACC_A acc
+#define MC_STATIC_GET_ACC_F(F, X, Y, A) (F)
+#define MC_STATIC_GET_ACC_X(F, X, Y, A) (X)
+#define MC_STATIC_GET_ACC_Y(F, X, Y, A) (Y)
+#define MC_STATIC_GET_ACC_A(F, X, Y, A) (A)
+#define MC_STATIC_ACC_NEXT(acc, node)               \
+    (MC_STATIC_ACC_F(acc) + MC_STATIC_NODE_F(node), \
+     MC_STATIC_ACC_X(acc) + MC_STATIC_NODE_X(node), \
+     MC_STATIC_ACC_Y(acc) + MC_STATIC_NODE_Y(node), \
+     MC_STATIC_ACC_A(acc) + MC_STATIC_NODE_A(node))
+
+// --- [Internal] Fold: FUNC(ARG, offsets of children before node, node) ---
+// Up to 64 children, like MC_DEFINE_COMPOSITE_DRIVER.
+#define MC_STATIC_FOLD(FUNC, ARG, ...) \
+    MC_INDIRECT_EXPAND(MC_STATIC_FOLD_IMPL, (MC_COUNT_ARGS(__VA_ARGS__), FUNC, ARG, __VA_ARGS__))
+#define MC_STATIC_FOLD_IMPL(N, FUNC, ARG, ...) MC_STATIC_FOLD_IMPL_##N(FUNC, ARG, (0, 0, 0, 0), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_1(FUNC, ARG, ACC, x) FUNC(ARG, ACC, x)
+#define MC_STATIC_FOLD_IMPL_2(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_1(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_3(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_2(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_4(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_3(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_5(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_4(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_6(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_5(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_7(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_6(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_8(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_7(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_9(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_8(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_10(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_9(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_11(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_10(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_12(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_11(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_13(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_12(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_14(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_13(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_15(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_14(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_16(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_15(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_17(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_16(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_18(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_17(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_19(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_18(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_20(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_19(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_21(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_20(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_22(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_21(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_23(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_22(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_24(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_23(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_25(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_24(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_26(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_25(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_27(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_26(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_28(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_27(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_29(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_28(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_30(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_29(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_31(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_30(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_32(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_31(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_33(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_32(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_34(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_33(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_35(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_34(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_36(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_35(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_37(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_36(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_38(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_37(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_39(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_38(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_40(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_39(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_41(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_40(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_42(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_41(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_43(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_42(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_44(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_43(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_45(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_44(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_46(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_45(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_47(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_46(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_48(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_47(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_49(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_48(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_50(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_49(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_51(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_50(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_52(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_51(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_53(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_52(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_54(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_53(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_55(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_54(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_56(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_55(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_57(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_56(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_58(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_57(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_59(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_58(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_60(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_59(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_61(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_60(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_62(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_61(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_63(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_62(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+#define MC_STATIC_FOLD_IMPL_64(FUNC, ARG, ACC, x, ...) FUNC(ARG, ACC, x) MC_STATIC_FOLD_IMPL_63(FUNC, ARG, MC_STATIC_ACC_NEXT(ACC, x), __VA_ARGS__)
+
+// --- [Internal] Per Child Statements ---
+// Optional op of a child, or FALLBACK if the child has none.
+#define MC_STATIC_CALL(node, OP, FALLBACK, ...)         \
+    (MC_STATIC_NODE_DRIVER(node)->OP                    \
+         ? MC_STATIC_NODE_DRIVER(node)->OP(__VA_ARGS__) \
+         : FALLBACK)
+
+#define MC_STATIC_PLUS(GET, ACC, node) +GET(node)
+
+#define MC_STATIC_CHECK_COUNT(T, node, OP, N)          \
+    MC_ASSERT((MC_STATIC_NODE_DRIVER(node)->OP         \
+                   ? MC_STATIC_NODE_DRIVER(node)->OP(  \
+                         MC_STATIC_CHILD_CTX(T, node)) \
+                   : 0) == N);
+
+#define MC_STATIC_INIT(T, ACC, node)                                           \
+    if (MC_STATIC_NODE_DRIVER(node)->init)                                     \
+    {                                                                          \
+        MC_STATIC_NODE_DRIVER(node)->init(MC_STATIC_CHILD_CTX(T, node));       \
+    }                                                                          \
+    /* Declared counts must match the child */                                 \
+    MC_STATIC_CHECK_COUNT(T, node, get_function_count, MC_STATIC_NODE_F(node)) \
+    MC_STATIC_CHECK_COUNT(T, node, get_input_count, MC_STATIC_NODE_X(node))    \
+    MC_STATIC_CHECK_COUNT(T, node, get_output_count, MC_STATIC_NODE_Y(node))   \
+    MC_STATIC_CHECK_COUNT(T, node, get_alias_count, MC_STATIC_NODE_A(node))    \
+    /* Members past the ID range, build with MC_SYS_WIDE_IDS=1 */              \
+    MC_ASSERT_ALWAYS(MC_STATIC_ACC_F(ACC) + MC_STATIC_NODE_F(node) <=          \
+                     MC_SYS_MAX_ID);                                           \
+    MC_ASSERT_ALWAYS(MC_STATIC_ACC_X(ACC) + MC_STATIC_NODE_X(node) <=          \
+                     MC_SYS_MAX_ID);                                           \
+    MC_ASSERT_ALWAYS(MC_STATIC_ACC_Y(ACC) + MC_STATIC_NODE_Y(node) <=          \
+                     MC_SYS_MAX_ID);                                           \
+    MC_ASSERT_ALWAYS(MC_STATIC_ACC_A(ACC) + MC_STATIC_NODE_A(node) <=          \
+                     MC_SYS_MAX_ID);
+
+#define MC_STATIC_INVOKE(T, ACC, node)                              \
+    if (id < MC_STATIC_ACC_F(ACC) + MC_STATIC_NODE_F(node))         \
+    {                                                               \
+        return MC_STATIC_CALL(node, invoke, MC_ERROR_NOT_SUPPORTED, \
+                              MC_STATIC_CHILD_CTX(T, node),         \
+                              id - MC_STATIC_ACC_F(ACC), args, c);  \
+    }
+
+#define MC_STATIC_WRITE_INPUT(T, ACC, node)                              \
+    if (id < MC_STATIC_ACC_X(ACC) + MC_STATIC_NODE_X(node))              \
+    {                                                                    \
+        return MC_STATIC_CALL(node, write_input, MC_ERROR_NOT_SUPPORTED, \
+                              MC_STATIC_CHILD_CTX(T, node),              \
+                              id - MC_STATIC_ACC_X(ACC), val);           \
+    }
+
+#define MC_STATIC_READ_INPUT(T, ACC, node)                        \
+    if (id < MC_STATIC_ACC_X(ACC) + MC_STATIC_NODE_X(node))       \
+    {                                                             \
+        return MC_STATIC_CALL(node, read_input,                   \
+                              MC_ERR_VAL(MC_ERROR_NOT_SUPPORTED), \
+                              MC_STATIC_CHILD_CTX(T, node),       \
+                              id - MC_STATIC_ACC_X(ACC));         \
+    }
+
+#define MC_STATIC_READ_OUTPUT(T, ACC, node)                       \
+    if (id < MC_STATIC_ACC_Y(ACC) + MC_STATIC_NODE_Y(node))       \
+    {                                                             \
+        return MC_STATIC_CALL(node, read_output,                  \
+                              MC_ERR_VAL(MC_ERROR_NOT_SUPPORTED), \
+                              MC_STATIC_CHILD_CTX(T, node),       \
+                              id - MC_STATIC_ACC_Y(ACC));         \
+    }
+
+#define MC_STATIC_GET_ALIAS(T, ACC, node)                                            \
+    if (id < MC_STATIC_ACC_A(ACC) + MC_STATIC_NODE_A(node))                          \
+    {                                                                                \
+        mc_status_t result = MC_STATIC_CALL(node, get_alias, MC_ERROR_NOT_SUPPORTED, \
+                                            MC_STATIC_CHILD_CTX(T, node),            \
+                                            id - MC_STATIC_ACC_A(ACC), info);        \
+        if (result == MC_OK)                                                         \
+        {                                                                            \
+            info->id += info->type == MC_CMD_TYPE_FUNC    ? MC_STATIC_ACC_F(ACC)     \
+                        : info->type == MC_CMD_TYPE_INPUT ? MC_STATIC_ACC_X(ACC)     \
+                                                          : MC_STATIC_ACC_Y(ACC);    \
+        }                                                                            \
+        return result;                                                               \
+    }
+
+#define MC_STATIC_UPDATE(T, ACC, node)                         \
+    if (MC_STATIC_NODE_DRIVER(node)->update)                   \
+    {                                                          \
+        mc_status_t err = MC_STATIC_NODE_DRIVER(node)->update( \
+            MC_STATIC_CHILD_CTX(T, node), dt_ms);              \
+        ret = ret != MC_OK ? ret : err;                        \
+    }
+
+#define MC_STATIC_HAS_UPDATE(T, ACC, node)   \
+    if (MC_STATIC_NODE_DRIVER(node)->update) \
+    {                                        \
+        return true;                         \
+    }
+
+// --- THE MAIN MACRO ---
+// Composite with constant children counts. Dispatch is an if chain over
+// constant offsets, so there are no loops or count calls at runtime.
+// Batch ops fall back to the single member ops.
+// Usage: MC_DEFINE_STATIC_COMPOSITE_DRIVER(rgb_driver, rgb_ctx_t,
+//            MC_STATIC_NODE(r, &pwm_drv, 0, 1, 1, 2), ...)
+#define MC_DEFINE_STATIC_COMPOSITE_DRIVER(NAME, CTX_TYPE_ARG, ...)                \
+    static void NAME##_init(void *ctx)                                            \
+    {                                                                             \
+        MC_STATIC_FOLD(MC_STATIC_INIT, CTX_TYPE_ARG, __VA_ARGS__)                 \
+    }                                                                             \
+    static mc_status_t NAME##_invoke(void *ctx, mc_sys_id_t id, int32_t *args,    \
+                                     uint8_t c)                                   \
+    {                                                                             \
+        MC_STATIC_FOLD(MC_STATIC_INVOKE, CTX_TYPE_ARG, __VA_ARGS__)               \
+        return MC_ERROR_INVALID_ARGS;                                             \
+    }                                                                             \
+    static mc_status_t NAME##_write_input(void *ctx, mc_sys_id_t id, int32_t val) \
+    {                                                                             \
+        MC_STATIC_FOLD(MC_STATIC_WRITE_INPUT, CTX_TYPE_ARG, __VA_ARGS__)          \
+        return MC_ERROR_INVALID_ARGS;                                             \
+    }                                                                             \
+    static mc_result_t NAME##_read_input(void *ctx, mc_sys_id_t id)               \
+    {                                                                             \
+        MC_STATIC_FOLD(MC_STATIC_READ_INPUT, CTX_TYPE_ARG, __VA_ARGS__)           \
+        return MC_ERR_VAL(MC_ERROR_INVALID_ARGS);                                 \
+    }                                                                             \
+    static mc_result_t NAME##_read_output(void *ctx, mc_sys_id_t id)              \
+    {                                                                             \
+        MC_STATIC_FOLD(MC_STATIC_READ_OUTPUT, CTX_TYPE_ARG, __VA_ARGS__)          \
+        return MC_ERR_VAL(MC_ERROR_INVALID_ARGS);                                 \
+    }                                                                             \
+    static mc_status_t NAME##_get_alias(void *ctx, mc_sys_id_t id,                \
+                                        mc_sys_cmd_info_t *info)                  \
+    {                                                                             \
+        MC_STATIC_FOLD(MC_STATIC_GET_ALIAS, CTX_TYPE_ARG, __VA_ARGS__)            \
+        return MC_ERROR_INVALID_ARGS;                                             \
+    }                                                                             \
+    static mc_status_t NAME##_update(void *ctx, uint32_t dt_ms)                   \
+    {                                                                             \
+        mc_status_t ret = MC_OK;                                                  \
+        MC_STATIC_FOLD(MC_STATIC_UPDATE, CTX_TYPE_ARG, __VA_ARGS__)               \
+        return ret;                                                               \
+    }                                                                             \
+    static bool NAME##_has_update(void *ctx)                                      \
+    {                                                                             \
+        MC_STATIC_FOLD(MC_STATIC_HAS_UPDATE, CTX_TYPE_ARG, __VA_ARGS__)           \
+        return false;                                                             \
+    }                                                                             \
+    static mc_sys_id_t NAME##_get_function_count(void *ctx)                       \
+    {                                                                             \
+        return 0 MC_STATIC_FOLD(MC_STATIC_PLUS, MC_STATIC_NODE_F, __VA_ARGS__);   \
+    }                                                                             \
+    static mc_sys_id_t NAME##_get_input_count(void *ctx)                          \
+    {                                                                             \
+        return 0 MC_STATIC_FOLD(MC_STATIC_PLUS, MC_STATIC_NODE_X, __VA_ARGS__);   \
+    }                                                                             \
+    static mc_sys_id_t NAME##_get_output_count(void *ctx)                         \
+    {                                                                             \
+        return 0 MC_STATIC_FOLD(MC_STATIC_PLUS, MC_STATIC_NODE_Y, __VA_ARGS__);   \
+    }                                                                             \
+    static mc_sys_id_t NAME##_get_alias_count(void *ctx)                          \
+    {                                                                             \
+        return 0 MC_STATIC_FOLD(MC_STATIC_PLUS, MC_STATIC_NODE_A, __VA_ARGS__);   \
+    }                                                                             \
+                                                                                  \
+    const mc_system_driver_t NAME = {                                             \
+        .init = NAME##_init,                                                      \
+        .invoke = NAME##_invoke,                                                  \
+        .write_input = NAME##_write_input,                                        \
+        .read_input = NAME##_read_input,                                          \
+        .read_output = NAME##_read_output,                                        \
+        .get_alias = NAME##_get_alias,                                            \
+        .get_function_count = NAME##_get_function_count,                          \
+        .get_input_count = NAME##_get_input_count,                                \
+        .get_output_count = NAME##_get_output_count,                              \
+        .get_alias_count = NAME##_get_alias_count,                                \
+        .update = NAME##_update,                                                  \
+        .has_update = NAME##_has_update};
+
+#ifdef __cplusplus
+}
+#endif
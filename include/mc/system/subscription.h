@@ -0,0 +1,86 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "mc/event.h"
+#include "mc/list.h"
+#include "mc/system/core.h"
+
+// Macro for defining a subscription to output Y_ID of SYS. Listeners fire
+// when the output moves more than DEADBAND away from the last reported value.
+// Users should always use this.
+#define MC_DEFINE_SYS_SUBSCRIPTION(NAME, SYS, Y_ID, DEADBAND) \
+    static mc_sys_subscription_state_t NAME##_state = {0};    \
+    static const mc_sys_subscription_t NAME = {               \
+        .system = &SYS,                                       \
+        .y_id = Y_ID,                                         \
+        .deadband = DEADBAND,                                 \
+        .state = &NAME##_state}
+
+    /* Event data of a subscription. */
+    typedef struct mc_sys_output_change_t
+    {
+        const mc_system_t *system;
+        mc_sys_id_t y_id;
+        int32_t value;
+        int32_t previous; // Equal to value on the first report
+    } mc_sys_output_change_t;
+
+    struct mc_sys_subscription_t;
+
+    /* Subscription state. */
+    typedef struct mc_sys_subscription_state_t
+    {
+        mc_event_t event;
+        mc_node_t node;
+        const struct mc_sys_subscription_t *sub;
+        int32_t last_value;
+        bool has_value;
+        uint8_t is_initialized;
+    } mc_sys_subscription_state_t;
+
+    /**
+     * Subscription to one output of a system. Values come from
+     * mc_sys_poll_subscriptions or are pushed by drivers with
+     * mc_sys_notify_output. The first value is always reported, after that
+     * only changes bigger than deadband, measured from the last reported
+     * value so slow drifts are not lost. Event data: mc_sys_output_change_t.
+     */
+    typedef struct mc_sys_subscription_t
+    {
+        const mc_system_t *system;
+        mc_sys_id_t y_id;
+        uint32_t deadband;
+        mc_sys_subscription_state_t *state;
+    } mc_sys_subscription_t;
+
+    /* Attach subscription to its system. */
+    void mc_sys_subscribe(const mc_sys_subscription_t *sub);
+
+    /* Detach subscription from its system. */
+    void mc_sys_unsubscribe(const mc_sys_subscription_t *sub);
+
+    /* Register callback to subscription. */
+    void mc_sys_subscription_register(const mc_sys_subscription_t *sub,
+                                      mc_callback_t *cb);
+
+    /* Unregister callback from subscription. */
+    void mc_sys_subscription_unregister(const mc_sys_subscription_t *sub,
+                                        mc_callback_t *cb);
+
+    /* Read every subscribed output of sys and fire subscriptions that changed.
+     * Outputs that fail to read are skipped. Returns number of subscriptions
+     * fired. */
+    uint8_t mc_sys_poll_subscriptions(const mc_system_t *sys);
+
+    /* Report a new output value from a driver, without reading it back.
+     * Returns number of subscriptions fired. */
+    uint8_t mc_sys_notify_output(const mc_system_t *sys, mc_sys_id_t y_id,
+                                 int32_t value);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,72 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "mc/system/core.h"
+
+// Macro for defining a transaction staging up to CAPACITY input writes. Users
+// should always use this.
+#define MC_DEFINE_SYS_TRANSACTION(NAME, CAPACITY)         \
+    static const mc_system_t *NAME##_systems[CAPACITY];   \
+    static mc_sys_id_t NAME##_x_ids[CAPACITY];            \
+    static int32_t NAME##_values[CAPACITY];               \
+    static mc_sys_transaction_state_t NAME##_state = {0}; \
+    static const mc_sys_transaction_t NAME = {            \
+        .capacity = CAPACITY,                             \
+        .systems = NAME##_systems,                        \
+        .x_ids = NAME##_x_ids,                            \
+        .values = NAME##_values,                          \
+        .state = &NAME##_state}
+
+    /* Transaction state. */
+    typedef struct mc_sys_transaction_state_t
+    {
+        uint8_t count;
+        uint8_t is_initialized;
+    } mc_sys_transaction_state_t;
+
+    /**
+     * Stages input writes to any number of systems, then commits them in one
+     * pass. Nothing reaches a system before the commit, and each system gets
+     * all of its staged inputs in one mc_sys_commit_inputs call, so bus
+     * drivers can send them as one burst. Staged writes are kept grouped by
+     * system, in staging order.
+     *
+     * The commit is not a rollback point: a failing system neither stops nor
+     * undoes the writes to the others.
+     */
+    typedef struct mc_sys_transaction_t
+    {
+        uint8_t capacity;
+        const mc_system_t **systems;
+        mc_sys_id_t *x_ids;
+        int32_t *values;
+        mc_sys_transaction_state_t *state;
+    } mc_sys_transaction_t;
+
+    /* Start a transaction, discarding anything staged. */
+    void mc_sys_txn_begin(const mc_sys_transaction_t *txn);
+
+    /* Stage a write of x_id. Staging the same input again replaces the value.
+     * Returns MC_ERROR_NO_RESOURCE if full, or what mc_sys_write_input would
+     * return for a bad x_id or a system without inputs. */
+    mc_status_t mc_sys_txn_write(const mc_sys_transaction_t *txn,
+                                 const mc_system_t *sys, mc_sys_id_t x_id,
+                                 int32_t val);
+
+    /* Get number of staged writes. */
+    uint8_t mc_sys_txn_get_count(const mc_sys_transaction_t *txn);
+
+    /* Write everything staged, one call per system. Returns the first error.
+     * The transaction is empty afterwards. */
+    mc_status_t mc_sys_txn_commit(const mc_sys_transaction_t *txn);
+
+    /* Discard staged writes. */
+    void mc_sys_txn_abort(const mc_sys_transaction_t *txn);
+
+#ifdef __cplusplus
+}
+#endif
@@ -19,6 +19,9 @@ extern "C"
 
         // Blocking delay
         void (*delay)(void *ctx, uint32_t ms);
+
+        // Get current time in microseconds. Optional, used for profiling.
+        uint32_t (*get_us)(void *ctx);
     } mc_time_driver_t;
 
     /* Initialize the global system time module. */
@@ -27,6 +30,10 @@ extern "C"
     /* Get the current system time in milliseconds. */
     uint32_t mc_time_get_ms();
 
+    /* Get the current system time in microseconds. Falls back to millisecond
+     * resolution if the driver has no get_us. */
+    uint32_t mc_time_get_us();
+
     /* Blocking delay for a specified number of milliseconds. */
     void mc_time_delay(uint32_t ms);
 
@@ -10,6 +10,8 @@ extern "C"
 #include <stdint.h>
 #include <string.h>
 
+#include "mc/file_id.h"
+
 #define MC_ON 1
 #define MC_OFF 0
 #define MC_BIT_CHECK(val, bit) ((val) & (1U << (bit)))
@@ -19,6 +21,10 @@ extern "C"
 #define MC_STR_HELPER(x) #x
 #define MC_STR(x) MC_STR_HELPER(x)
 
+// Stop the compiler from reordering memory accesses across this point. Enough
+// to order accesses shared between an interrupt and the main loop.
+#define MC_COMPILER_BARRIER() __asm volatile("" ::: "memory")
+
 #ifndef MC_MIN
 #define MC_MIN(a, b) (((a) < (b)) ? (a) : (b))
 #endif
@@ -46,13 +52,78 @@ extern "C"
 
     void mc_assert_handler(const char *expr, const char *file, int line);
 
+#ifdef __FILE_NAME__
+#define __FILENAME__ __FILE_NAME__
+#else
 #define __FILENAME__ (strrchr(__FILE__, '/') ? strrchr(__FILE__, '/') + 1 : __FILE__)
+#endif
+
+// Assert tiers. Asserts above MC_ASSERT_LEVEL are compiled out.
+#define MC_ASSERT_LEVEL_ALWAYS 0   // Only MC_ASSERT_ALWAYS, for release builds
+#define MC_ASSERT_LEVEL_DEBUG 1    // Also MC_ASSERT
+#define MC_ASSERT_LEVEL_PARANOID 2 // Also MC_ASSERT_PARANOID, expensive checks
+
+#ifndef MC_ASSERT_LEVEL
+#define MC_ASSERT_LEVEL MC_ASSERT_LEVEL_DEBUG
+#endif
+
+// Set to 1 to report failed asserts by file ID and line only, which keeps
+// expression and file name strings out of flash. Sources set MC_FILE_ID, see
+// mc/file_id.h.
+#ifndef MC_ASSERT_COMPACT
+#define MC_ASSERT_COMPACT 0
+#endif
+
+#ifndef MC_FILE_ID
+#define MC_FILE_ID MC_FILE_ID_UNKNOWN
+#endif
+
+    void mc_assert_handler_compact(uint16_t file_id, int line);
+
+#if MC_ASSERT_COMPACT
+#define MC_ASSERT_FAIL(expr_str) mc_assert_handler_compact(MC_FILE_ID, __LINE__)
+#else
+#define MC_ASSERT_FAIL(expr_str) \
+    mc_assert_handler(expr_str, __FILENAME__, __LINE__)
+#endif
+
+// Assert that is never compiled out. Use for checks guarding memory safety.
+#define MC_ASSERT_ALWAYS(expr)     \
+    do                             \
+    {                              \
+        if (!(expr))               \
+        {                          \
+            MC_ASSERT_FAIL(#expr); \
+        }                          \
+    } while (0)
+
+// Disabled asserts still type check expr, but never evaluate it.
+#define MC_ASSERT_DISABLED(expr) \
+    do                           \
+    {                            \
+        (void)sizeof(expr);      \
+    } while (0)
+
+#if MC_ASSERT_LEVEL >= MC_ASSERT_LEVEL_DEBUG
+#define MC_ASSERT(expr) MC_ASSERT_ALWAYS(expr)
+#else
+#define MC_ASSERT(expr) MC_ASSERT_DISABLED(expr)
+#endif
+
+#if MC_ASSERT_LEVEL >= MC_ASSERT_LEVEL_PARANOID
+#define MC_ASSERT_PARANOID(expr) MC_ASSERT_ALWAYS(expr)
+#else
+#define MC_ASSERT_PARANOID(expr) MC_ASSERT_DISABLED(expr)
+#endif
+
+    // FNV-1a hash of len bytes. Used for name lookups.
+    uint32_t mc_hash_bytes(const void *data, size_t len);
+
+// Start value for mc_crc16_update.
+#define MC_CRC16_INIT 0xFFFF
 
-#define MC_ASSERT(expr)                                   \
-    if (!(expr))                                          \
-    {                                                     \
-        mc_assert_handler(#expr, __FILENAME__, __LINE__); \
-    }
+    // CRC-16/CCITT-FALSE of len bytes, continuing from crc. Used for framing.
+    uint16_t mc_crc16_update(uint16_t crc, const void *data, size_t len);
 
     // Struct for vector3
     typedef struct mc_vector3_t
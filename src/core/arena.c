@@ -0,0 +1,76 @@
+#define MC_FILE_ID MC_FILE_ID_ARENA
+
+#include "mc/arena.h"
+#include "mc/utils.h"
+
+#define CHECK_ARENA(arena)                                         \
+    do                                                             \
+    {                                                              \
+        MC_ASSERT(arena != NULL);                                  \
+        MC_ASSERT(arena->state->is_initialized == MC_INITIALIZED); \
+    } while (0)
+
+void mc_arena_init(const mc_arena_t *arena)
+{
+    MC_ASSERT(arena != NULL);
+    MC_ASSERT(arena->buffer != NULL);
+    MC_ASSERT(arena->state != NULL);
+
+    arena->state->offset = 0;
+    arena->state->high_water = 0;
+    arena->state->failure_count = 0;
+    arena->state->is_initialized = MC_INITIALIZED;
+}
+
+void *mc_arena_alloc(const mc_arena_t *arena, uint32_t size)
+{
+    CHECK_ARENA(arena);
+
+    // Offset is always aligned, so only the size needs rounding up.
+    uint32_t aligned_size = MC_ARENA_ALIGN_SIZE(size);
+    if (aligned_size < size ||
+        aligned_size > arena->size - arena->state->offset)
+    {
+        arena->state->failure_count++;
+        return NULL;
+    }
+
+    void *ptr = arena->buffer + arena->state->offset;
+    arena->state->offset += aligned_size;
+    if (arena->state->offset > arena->state->high_water)
+    {
+        arena->state->high_water = arena->state->offset;
+    }
+    return ptr;
+}
+
+mc_arena_mark_t mc_arena_mark(const mc_arena_t *arena)
+{
+    CHECK_ARENA(arena);
+    return arena->state->offset;
+}
+
+void mc_arena_reset_to(const mc_arena_t *arena, mc_arena_mark_t mark)
+{
+    CHECK_ARENA(arena);
+    // Mark must not be newer than the current position.
+    MC_ASSERT_ALWAYS(mark <= arena->state->offset);
+    arena->state->offset = mark;
+}
+
+void mc_arena_reset(const mc_arena_t *arena)
+{
+    CHECK_ARENA(arena);
+    arena->state->offset = 0;
+}
+
+void mc_arena_get_stats(const mc_arena_t *arena, mc_arena_stats_t *stats)
+{
+    CHECK_ARENA(arena);
+    MC_ASSERT(stats != NULL);
+
+    stats->size = arena->size;
+    stats->used = arena->state->offset;
+    stats->high_water = arena->state->high_water;
+    stats->failure_count = arena->state->failure_count;
+}
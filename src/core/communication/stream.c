@@ -1,3 +1,5 @@
+#define MC_FILE_ID MC_FILE_ID_STREAM
+
 #include "mc/communication/stream.h"
 #include "mc/utils.h"
 #include <stdio.h>
@@ -1,3 +1,5 @@
+#define MC_FILE_ID MC_FILE_ID_DEBUG
+
 #include <stdarg.h>
 #include "mc/debug.h"
 #include "mc/time.h"
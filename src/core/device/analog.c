@@ -1,3 +1,5 @@
+#define MC_FILE_ID MC_FILE_ID_ANALOG
+
 #include "mc/device/analog.h"
 #include "mc/utils.h"
 
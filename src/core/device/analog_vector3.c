@@ -1,3 +1,5 @@
+#define MC_FILE_ID MC_FILE_ID_ANALOG_VECTOR3
+
 #include "mc/device/analog_vector3.h"
 #include "mc/utils.h"
 
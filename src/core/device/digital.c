@@ -1,3 +1,5 @@
+#define MC_FILE_ID MC_FILE_ID_DIGITAL
+
 #include "mc/device/digital.h"
 #include "mc/utils.h"
 #include <stdbool.h>
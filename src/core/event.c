@@ -1,11 +1,54 @@
+#define MC_FILE_ID MC_FILE_ID_EVENT
+
 #include "mc/event.h"
 #include "mc/list.h"
 #include "mc/utils.h"
+#if MC_EVENT_PROFILING
+#include "mc/time.h"
+#endif
+
+// Queue used by mc_event_post and mc_event_dispatch_pending.
+static const mc_event_queue_t *pending_queue = NULL;
+
+#if MC_EVENT_PROFILING
+// Events shown in profile dumps.
+MC_DEFINE_LIST(profiled_events);
+
+// Helper: clear callback stats.
+static void reset_stats(mc_callback_stats_t *stats)
+{
+    stats->call_count = 0;
+    stats->min_us = 0;
+    stats->max_us = 0;
+    stats->total_us = 0;
+}
+
+// Helper: add one callback execution to stats.
+static void record_stats(mc_callback_stats_t *stats, uint32_t elapsed_us)
+{
+    stats->call_count++;
+    stats->total_us += elapsed_us;
+    // First call sets min, since statically defined callbacks start at 0.
+    if (stats->call_count == 1 || elapsed_us < stats->min_us)
+    {
+        stats->min_us = elapsed_us;
+    }
+    if (elapsed_us > stats->max_us)
+    {
+        stats->max_us = elapsed_us;
+    }
+}
+#endif
 
 void mc_event_init(mc_event_t *event)
 {
     MC_ASSERT(event != NULL);
     mc_list_init(&event->listeners);
+    event->pending_data = NULL;
+    event->is_pending = false;
+#if MC_EVENT_PROFILING
+    event->trigger_count = 0;
+#endif
 }
 
 void mc_callback_init(mc_callback_t *cb, mc_callback_func_t func, void *ctx)
@@ -13,13 +56,56 @@ void mc_callback_init(mc_callback_t *cb, mc_callback_func_t func, void *ctx)
     MC_ASSERT(cb != NULL);
     cb->func = func;
     cb->ctx = ctx;
+    cb->filter = NULL;
+    cb->priority = MC_EVENT_PRIORITY_DEFAULT;
+#if MC_EVENT_PROFILING
+    reset_stats(&cb->stats);
+#endif
+}
+
+void mc_filter_init(mc_callback_t *cb, mc_filter_func_t filter, void *ctx,
+                    int8_t priority)
+{
+    MC_ASSERT(cb != NULL);
+    cb->func = NULL;
+    cb->ctx = ctx;
+    cb->filter = filter;
+    cb->priority = priority;
+#if MC_EVENT_PROFILING
+    reset_stats(&cb->stats);
+#endif
+}
+
+void mc_callback_set_priority(mc_callback_t *cb, int8_t priority)
+{
+    MC_ASSERT(cb != NULL);
+    cb->priority = priority;
 }
 
 void mc_event_register(mc_event_t *event, mc_callback_t *cb)
 {
     MC_ASSERT(event != NULL);
     MC_ASSERT(cb != NULL);
-    mc_list_append(&event->listeners, &cb->node);
+
+    // Fast path: most callbacks share a priority, so just append.
+    mc_node_t *tail = mc_list_peek_tail(&event->listeners);
+    if (tail == NULL ||
+        MC_LIST_ENTRY(tail, mc_callback_t, node)->priority >= cb->priority)
+    {
+        mc_list_append(&event->listeners, &cb->node);
+        return;
+    }
+
+    // Insert before the first callback with a lower priority.
+    mc_node_t *curr;
+    MC_LIST_FOR_EACH(curr, &event->listeners)
+    {
+        if (MC_LIST_ENTRY(curr, mc_callback_t, node)->priority < cb->priority)
+        {
+            break;
+        }
+    }
+    mc_list_insert_before(&event->listeners, curr, &cb->node);
 }
 
 void mc_event_unregister(mc_event_t *event, mc_callback_t *cb)
@@ -34,6 +120,9 @@ void mc_event_trigger(mc_event_t *event, void *event_data)
     MC_ASSERT(event != NULL);
     mc_node_t *curr;
     mc_node_t *storage;
+#if MC_EVENT_PROFILING
+    event->trigger_count++;
+#endif
 
     // USE SAFE ITERATION:
     // This allows a callback to call 'mc_event_unregister' on itself
@@ -44,10 +133,249 @@ void mc_event_trigger(mc_event_t *event, void *event_data)
         // Recover the callback struct from the generic node
         mc_callback_t *cb = MC_LIST_ENTRY(curr, mc_callback_t, node);
 
-        // Execute
-        if (cb->func)
+#if MC_EVENT_PROFILING
+        uint32_t start_us = mc_time_get_us();
+#endif
+        // Execute. Filters can consume the event.
+        mc_event_action_t action = MC_EVENT_CONTINUE;
+        if (cb->filter)
+        {
+            action = cb->filter(cb->ctx, event_data);
+        }
+        else if (cb->func)
         {
             cb->func(cb->ctx, event_data);
         }
+#if MC_EVENT_PROFILING
+        record_stats(&cb->stats, mc_time_get_us() - start_us);
+#endif
+        if (action == MC_EVENT_STOP)
+        {
+            return;
+        }
+    }
+}
+
+void mc_static_event_trigger(const mc_static_event_t *event, void *event_data)
+{
+    MC_ASSERT(event != NULL);
+
+    // Tight loop over the const table, no list traversal.
+    const mc_callback_func_t *handlers = event->handlers;
+    for (uint16_t i = 0; i < event->count; i++)
+    {
+        handlers[i](NULL, event_data);
+    }
+
+    if (event->dynamic->listeners.count > 0)
+    {
+        mc_event_trigger(event->dynamic, event_data);
+    }
+}
+
+void mc_static_event_register(const mc_static_event_t *event,
+                              mc_callback_t *cb)
+{
+    MC_ASSERT(event != NULL);
+    mc_event_register(event->dynamic, cb);
+}
+
+void mc_static_event_unregister(const mc_static_event_t *event,
+                                mc_callback_t *cb)
+{
+    MC_ASSERT(event != NULL);
+    mc_event_unregister(event->dynamic, cb);
+}
+
+void mc_event_queue_init(const mc_event_queue_t *queue)
+{
+    MC_ASSERT(queue != NULL);
+    MC_ASSERT(queue->entries != NULL);
+    MC_ASSERT(queue->state != NULL);
+    // Positions run up to 2 * capacity, which must fit in uint16_t.
+    MC_ASSERT(queue->capacity > 0 && queue->capacity <= 0x8000);
+
+    queue->state->head = 0;
+    queue->state->tail = 0;
+    queue->state->dropped = 0;
+    queue->state->is_initialized = MC_INITIALIZED;
+    pending_queue = queue;
+}
+
+// Helper: next queue position. Positions run over [0, 2 * capacity), so a full
+// queue (head - tail == capacity) differs from an empty one without a count
+// shared by producer and consumer.
+static uint16_t next_position(uint16_t pos, uint16_t capacity)
+{
+    uint32_t next = (uint32_t)pos + 1;
+    return next == 2u * capacity ? 0 : (uint16_t)next;
+}
+
+// Helper: entry index of a queue position.
+static uint16_t position_to_index(uint16_t pos, uint16_t capacity)
+{
+    return pos >= capacity ? pos - capacity : pos;
+}
+
+// Helper: number of entries between tail and head.
+static uint16_t used_entries(uint16_t head, uint16_t tail, uint16_t capacity)
+{
+    return head >= tail ? head - tail : (uint16_t)(head + 2u * capacity - tail);
+}
+
+// Helper: push entry to pending queue.
+static mc_status_t enqueue(mc_event_t *event, void *event_data,
+                           bool is_coalesced)
+{
+    if (pending_queue == NULL)
+    {
+        return MC_ERROR;
+    }
+
+    mc_event_queue_state_t *state = pending_queue->state;
+    uint16_t capacity = pending_queue->capacity;
+    uint16_t head = state->head;
+    if (used_entries(head, state->tail, capacity) >= capacity)
+    {
+        state->dropped++;
+        return MC_ERROR_NO_RESOURCE;
+    }
+
+    mc_event_queue_entry_t *entry =
+        &pending_queue->entries[position_to_index(head, capacity)];
+    entry->event = event;
+    entry->data = event_data;
+    entry->is_coalesced = is_coalesced;
+
+    // Entry must be written before the consumer can see it.
+    MC_COMPILER_BARRIER();
+    state->head = next_position(head, capacity);
+    return MC_OK;
+}
+
+mc_status_t mc_event_post(mc_event_t *event, void *event_data)
+{
+    MC_ASSERT(event != NULL);
+    return enqueue(event, event_data, false);
+}
+
+mc_status_t mc_event_post_coalesced(mc_event_t *event, void *event_data)
+{
+    MC_ASSERT(event != NULL);
+
+    // Always publish the data first. If dispatch clears is_pending between
+    // these two steps, we queue again and the data is delivered twice rather
+    // than lost.
+    event->pending_data = event_data;
+    MC_COMPILER_BARRIER();
+    if (event->is_pending)
+    {
+        return MC_OK;
+    }
+
+    event->is_pending = true;
+    mc_status_t ret = enqueue(event, NULL, true);
+    if (ret != MC_OK)
+    {
+        event->is_pending = false;
+    }
+    return ret;
+}
+
+uint16_t mc_event_dispatch_pending(void)
+{
+    if (pending_queue == NULL)
+    {
+        return 0;
+    }
+
+    mc_event_queue_state_t *state = pending_queue->state;
+    uint16_t capacity = pending_queue->capacity;
+    // Only dispatch what was queued before now, so listeners that post again
+    // cannot keep us here forever.
+    uint16_t end = state->head;
+    uint16_t dispatched = 0;
+
+    while (state->tail != end)
+    {
+        uint16_t tail = state->tail;
+        mc_event_queue_entry_t entry =
+            pending_queue->entries[position_to_index(tail, capacity)];
+
+        // Entry is copied, so free the slot before running listeners.
+        MC_COMPILER_BARRIER();
+        state->tail = next_position(tail, capacity);
+
+        void *event_data = entry.data;
+        if (entry.is_coalesced)
+        {
+            entry.event->is_pending = false;
+            MC_COMPILER_BARRIER();
+            event_data = entry.event->pending_data;
+        }
+        mc_event_trigger(entry.event, event_data);
+        dispatched++;
+    }
+    return dispatched;
+}
+
+uint16_t mc_event_get_pending_count(void)
+{
+    if (pending_queue == NULL)
+    {
+        return 0;
+    }
+    return used_entries(pending_queue->state->head, pending_queue->state->tail,
+                        pending_queue->capacity);
+}
+
+uint16_t mc_event_get_dropped_count(void)
+{
+    if (pending_queue == NULL)
+    {
+        return 0;
+    }
+    return pending_queue->state->dropped;
+}
+
+#if MC_EVENT_PROFILING
+void mc_event_profile_register(mc_event_t *event, const char *name)
+{
+    MC_ASSERT(event != NULL);
+    event->name = name;
+    mc_list_append(&profiled_events, &event->profile_node);
+}
+
+mc_list_t *mc_event_profile_get_events(void)
+{
+    return &profiled_events;
+}
+
+uint32_t mc_event_get_trigger_count(const mc_event_t *event)
+{
+    MC_ASSERT(event != NULL);
+    return event->trigger_count;
+}
+
+uint32_t mc_callback_get_avg_us(const mc_callback_t *cb)
+{
+    MC_ASSERT(cb != NULL);
+    if (cb->stats.call_count == 0)
+    {
+        return 0;
+    }
+    return (uint32_t)(cb->stats.total_us / cb->stats.call_count);
+}
+
+void mc_event_profile_reset(mc_event_t *event)
+{
+    MC_ASSERT(event != NULL);
+    event->trigger_count = 0;
+
+    mc_node_t *curr;
+    MC_LIST_FOR_EACH(curr, &event->listeners)
+    {
+        reset_stats(&MC_LIST_ENTRY(curr, mc_callback_t, node)->stats);
     }
 }
+#endif
@@ -0,0 +1,93 @@
+#define MC_FILE_ID MC_FILE_ID_LATEST_EVENT
+
+#include "mc/latest_event.h"
+#include "mc/utils.h"
+
+#define CHECK_LATEST_EVENT(event)                                  \
+    do                                                             \
+    {                                                              \
+        MC_ASSERT(event != NULL);                                  \
+        MC_ASSERT(event->state->is_initialized == MC_INITIALIZED); \
+    } while (0)
+
+void mc_latest_event_init(const mc_latest_event_t *event)
+{
+    MC_ASSERT(event != NULL);
+    MC_ASSERT(event->pending != NULL);
+    MC_ASSERT(event->current != NULL);
+    MC_ASSERT(event->state != NULL);
+
+    mc_event_init(&event->state->event);
+    event->state->sequence = 0;
+    event->state->is_dirty = false;
+    event->state->superseded_count = 0;
+    event->state->is_initialized = MC_INITIALIZED;
+}
+
+void mc_latest_event_publish(const mc_latest_event_t *event, const void *value)
+{
+    CHECK_LATEST_EVENT(event);
+    MC_ASSERT(value != NULL);
+    mc_latest_event_state_t *state = event->state;
+
+    state->sequence++;
+    MC_COMPILER_BARRIER();
+    memcpy(event->pending, value, event->size);
+    MC_COMPILER_BARRIER();
+    state->sequence++;
+
+    if (state->is_dirty)
+    {
+        state->superseded_count++;
+    }
+    else
+    {
+        state->is_dirty = true;
+    }
+}
+
+bool mc_latest_event_dispatch(const mc_latest_event_t *event)
+{
+    CHECK_LATEST_EVENT(event);
+    mc_latest_event_state_t *state = event->state;
+
+    if (!state->is_dirty)
+    {
+        return false;
+    }
+
+    // Copy pending value out. Retry if a publish happened in the middle, so
+    // listeners never see a torn value.
+    uint32_t sequence;
+    do
+    {
+        sequence = state->sequence;
+        state->is_dirty = false;
+        MC_COMPILER_BARRIER();
+        memcpy(event->current, event->pending, event->size);
+        MC_COMPILER_BARRIER();
+    } while ((sequence & 1) || sequence != state->sequence);
+
+    mc_event_trigger(&state->event, event->current);
+    return true;
+}
+
+void mc_latest_event_register(const mc_latest_event_t *event,
+                              mc_callback_t *cb)
+{
+    CHECK_LATEST_EVENT(event);
+    mc_event_register(&event->state->event, cb);
+}
+
+void mc_latest_event_unregister(const mc_latest_event_t *event,
+                                mc_callback_t *cb)
+{
+    CHECK_LATEST_EVENT(event);
+    mc_event_unregister(&event->state->event, cb);
+}
+
+uint32_t mc_latest_event_get_superseded_count(const mc_latest_event_t *event)
+{
+    CHECK_LATEST_EVENT(event);
+    return event->state->superseded_count;
+}
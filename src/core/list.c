@@ -1,6 +1,22 @@
+#define MC_FILE_ID MC_FILE_ID_LIST
+
 #include "mc/list.h"
 #include "mc/utils.h"
 
+// Helper: walks the list to check whether node is linked into it.
+static bool list_contains(mc_list_t *list, mc_node_t *node)
+{
+    mc_node_t *pos;
+    MC_LIST_FOR_EACH(pos, list)
+    {
+        if (pos == node)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 void mc_list_init(mc_list_t *list)
 {
     MC_ASSERT(list != NULL);
@@ -55,6 +71,31 @@ void mc_list_prepend(mc_list_t *list, mc_node_t *node)
     list->count++;
 }
 
+void mc_list_insert_before(mc_list_t *list, mc_node_t *pos, mc_node_t *node)
+{
+    MC_ASSERT(list != NULL);
+    MC_ASSERT(node != NULL);
+    if (pos == NULL)
+    {
+        mc_list_append(list, node);
+        return;
+    }
+    MC_ASSERT_PARANOID(list_contains(list, pos));
+    if (pos == list->head)
+    {
+        mc_list_prepend(list, node);
+        return;
+    }
+
+    // Somewhere in the middle, link between pos->prev and pos
+    node->prev = pos->prev;
+    node->next = pos;
+    pos->prev->next = node;
+    pos->prev = node;
+
+    list->count++;
+}
+
 void mc_list_remove(mc_list_t *list, mc_node_t *node)
 {
     MC_ASSERT(list != NULL);
@@ -0,0 +1,158 @@
+#define MC_FILE_ID MC_FILE_ID_POOL
+
+#include "mc/pool.h"
+#include "mc/utils.h"
+
+#define CHECK_POOL(pool)                                          \
+    do                                                            \
+    {                                                             \
+        MC_ASSERT(pool != NULL);                                  \
+        MC_ASSERT(pool->state->is_initialized == MC_INITIALIZED); \
+    } while (0)
+
+// Helper: index of lowest set bit. word must not be 0.
+static inline uint8_t count_trailing_zeros(uint32_t word)
+{
+#if defined(__GNUC__)
+    return (uint8_t)__builtin_ctz(word);
+#else
+    uint8_t n = 0;
+    while ((word & 1U) == 0)
+    {
+        word >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+// Helper: claim a free bit. Returns block index, or -1 if none is free.
+static int32_t claim_block(const mc_pool_t *pool)
+{
+    uint16_t words = MC_POOL_BITMAP_WORDS(pool->block_count);
+    for (uint16_t w = 0; w < words; w++)
+    {
+#if MC_POOL_LOCK_FREE
+        uint32_t word = __atomic_load_n(&pool->bitmap[w], __ATOMIC_RELAXED);
+        while (word != 0)
+        {
+            uint8_t bit = count_trailing_zeros(word);
+            // On failure, word is reloaded with the current value.
+            if (__atomic_compare_exchange_n(&pool->bitmap[w], &word,
+                                            word & ~(1U << bit), false,
+                                            __ATOMIC_ACQUIRE,
+                                            __ATOMIC_RELAXED))
+            {
+                return w * 32 + bit;
+            }
+        }
+#else
+        uint32_t word = pool->bitmap[w];
+        if (word != 0)
+        {
+            uint8_t bit = count_trailing_zeros(word);
+            MC_BIT_CLEAR(pool->bitmap[w], bit);
+            return w * 32 + bit;
+        }
+#endif
+    }
+    return -1;
+}
+
+// Helper: update usage statistics after a successful alloc.
+static void record_alloc(mc_pool_state_t *state)
+{
+#if MC_POOL_LOCK_FREE
+    uint16_t used = __atomic_add_fetch(&state->used_count, 1, __ATOMIC_RELAXED);
+    uint16_t high = __atomic_load_n(&state->high_water, __ATOMIC_RELAXED);
+    while (used > high &&
+           !__atomic_compare_exchange_n(&state->high_water, &high, used, false,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+#else
+    state->used_count++;
+    if (state->used_count > state->high_water)
+    {
+        state->high_water = state->used_count;
+    }
+#endif
+}
+
+void mc_pool_init(const mc_pool_t *pool)
+{
+    MC_ASSERT(pool != NULL);
+    MC_ASSERT(pool->storage != NULL);
+    MC_ASSERT(pool->bitmap != NULL);
+    MC_ASSERT(pool->state != NULL);
+    MC_ASSERT(pool->block_size > 0 && pool->block_count > 0);
+
+    // Mark every existing block free. Unused bits of the last word stay 0.
+    uint16_t words = MC_POOL_BITMAP_WORDS(pool->block_count);
+    for (uint16_t w = 0; w < words; w++)
+    {
+        uint16_t remaining = pool->block_count - w * 32;
+        pool->bitmap[w] = remaining >= 32 ? 0xFFFFFFFFU
+                                          : (1U << remaining) - 1;
+    }
+    pool->state->used_count = 0;
+    pool->state->high_water = 0;
+    pool->state->failure_count = 0;
+    pool->state->is_initialized = MC_INITIALIZED;
+}
+
+void *mc_pool_alloc(const mc_pool_t *pool)
+{
+    CHECK_POOL(pool);
+
+    int32_t index = claim_block(pool);
+    if (index < 0)
+    {
+#if MC_POOL_LOCK_FREE
+        __atomic_add_fetch(&pool->state->failure_count, 1, __ATOMIC_RELAXED);
+#else
+        pool->state->failure_count++;
+#endif
+        return NULL;
+    }
+    record_alloc(pool->state);
+    return pool->storage + (uint32_t)index * pool->block_size;
+}
+
+void mc_pool_free(const mc_pool_t *pool, void *block)
+{
+    CHECK_POOL(pool);
+    MC_ASSERT(block != NULL);
+
+    // Block must point at the start of a block inside storage.
+    MC_ASSERT_ALWAYS((uint8_t *)block >= pool->storage);
+    MC_ASSERT_ALWAYS((uint8_t *)block <
+                     pool->storage + (uint32_t)pool->block_count * pool->block_size);
+    uint32_t offset = (uint32_t)((uint8_t *)block - pool->storage);
+    MC_ASSERT_ALWAYS(offset % pool->block_size == 0);
+    uint32_t index = offset / pool->block_size;
+
+    uint32_t mask = 1U << (index % 32);
+#if MC_POOL_LOCK_FREE
+    uint32_t prev = __atomic_fetch_or(&pool->bitmap[index / 32], mask,
+                                      __ATOMIC_RELEASE);
+    MC_ASSERT_ALWAYS((prev & mask) == 0); // Double free
+    __atomic_sub_fetch(&pool->state->used_count, 1, __ATOMIC_RELAXED);
+#else
+    MC_ASSERT_ALWAYS((pool->bitmap[index / 32] & mask) == 0); // Double free
+    pool->bitmap[index / 32] |= mask;
+    pool->state->used_count--;
+#endif
+}
+
+void mc_pool_get_stats(const mc_pool_t *pool, mc_pool_stats_t *stats)
+{
+    CHECK_POOL(pool);
+    MC_ASSERT(stats != NULL);
+
+    stats->block_size = pool->block_size;
+    stats->block_count = pool->block_count;
+    stats->used_count = pool->state->used_count;
+    stats->high_water = pool->state->high_water;
+    stats->failure_count = pool->state->failure_count;
+}
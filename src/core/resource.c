@@ -1,6 +1,10 @@
+#define MC_FILE_ID MC_FILE_ID_RESOURCE
+
 #include "mc/resource.h"
 #include "mc/utils.h"
+#include "mc/time.h"
 #include <stddef.h>
+#include <string.h>
 
 void *mc_resource_acquire(const mc_resource_manager_t *mgr, int32_t key)
 {
@@ -63,4 +67,335 @@ void mc_resource_release_key(const mc_resource_manager_t *mgr, int32_t key)
             return;
         }
     }
-}
\ No newline at end of file
+}
+
+#define CHECK_RESOURCE_TABLE(table)                                \
+    do                                                             \
+    {                                                              \
+        MC_ASSERT(table != NULL);                                  \
+        MC_ASSERT(table->state->is_initialized == MC_INITIALIZED); \
+    } while (0)
+
+// Helper: Fibonacci hash of a 32-bit value into [0, len)
+static inline uint16_t hash_u32(uint32_t x, uint16_t len)
+{
+    return (uint16_t)(((x * 2654435761u) >> 16) % len);
+}
+
+// Helper: home slot of an entry in the key or data index
+static inline uint16_t home_slot(const mc_resource_table_t *table,
+                                 uint16_t entry, bool is_key_index)
+{
+    const mc_resource_entry_t *e = &table->pool[entry];
+    uint32_t x = is_key_index ? (uint32_t)e->key
+                              : (uint32_t)((uintptr_t)e->data >> 2);
+    return hash_u32(x, table->index_len);
+}
+
+// Helper: find slot holding key. Returns MC_RESOURCE_NONE if missing.
+static uint16_t find_key_slot(const mc_resource_table_t *table, int32_t key)
+{
+    uint16_t i = hash_u32((uint32_t)key, table->index_len);
+    while (table->key_index[i] != 0)
+    {
+        if (table->pool[table->key_index[i] - 1].key == key)
+        {
+            return i;
+        }
+        i = (i + 1) % table->index_len;
+    }
+    return MC_RESOURCE_NONE;
+}
+
+// Helper: find entry holding data pointer. Returns MC_RESOURCE_NONE if missing.
+static uint16_t find_data_entry(const mc_resource_table_t *table, void *data)
+{
+    uint16_t i = hash_u32((uint32_t)((uintptr_t)data >> 2), table->index_len);
+    while (table->data_index[i] != 0)
+    {
+        uint16_t entry = table->data_index[i] - 1;
+        if (table->pool[entry].data == data)
+        {
+            return entry;
+        }
+        i = (i + 1) % table->index_len;
+    }
+    return MC_RESOURCE_NONE;
+}
+
+// Helper: insert entry into index at its home slot, probing linearly.
+static void index_insert(const mc_resource_table_t *table, uint16_t *index,
+                         uint16_t entry, bool is_key_index)
+{
+    uint16_t i = home_slot(table, entry, is_key_index);
+    while (index[i] != 0)
+    {
+        i = (i + 1) % table->index_len;
+    }
+    index[i] = entry + 1;
+}
+
+// Helper: remove slot from key index. Shifts later entries of the same probe
+// run back, so no tombstones are needed and lookups stay short.
+static void key_index_remove(const mc_resource_table_t *table, uint16_t slot)
+{
+    uint16_t *index = table->key_index;
+    uint16_t len = table->index_len;
+    index[slot] = 0;
+
+    uint16_t j = slot;
+    while (true)
+    {
+        j = (j + 1) % len;
+        if (index[j] == 0)
+        {
+            return;
+        }
+
+        // Move entry at j into the hole unless its home lies cyclically in
+        // (slot, j], in which case it is still reachable.
+        uint16_t home = home_slot(table, index[j] - 1, true);
+        bool reachable = (slot <= j) ? (slot < home && home <= j)
+                                     : (slot < home || home <= j);
+        if (!reachable)
+        {
+            index[slot] = index[j];
+            index[j] = 0;
+            slot = j;
+        }
+    }
+}
+
+// Helper: release entry found at key slot.
+static void release_slot(const mc_resource_table_t *table, uint16_t slot)
+{
+    uint16_t entry = table->key_index[slot] - 1;
+    key_index_remove(table, slot);
+
+    // Invalidate outstanding handles.
+    table->pool[entry].generation++;
+    table->pool[entry].is_busy = false;
+    table->pool[entry].next = table->state->free_head;
+    table->state->free_head = entry;
+    table->state->used_count--;
+}
+
+// Helper: check if lease of busy entry ran out. Only for tables with leases.
+static bool is_expired(const mc_resource_table_t *table, uint16_t entry,
+                       uint32_t now)
+{
+    return (int32_t)(now - table->pool[entry].expires_ms) >= 0;
+}
+
+// Helper: start a new lease.
+static void renew_lease(const mc_resource_table_t *table, uint16_t entry)
+{
+    if (table->lease_ms != 0)
+    {
+        table->pool[entry].expires_ms = mc_time_get_ms() + table->lease_ms;
+    }
+}
+
+// Helper: find live entry by key. Expired entries are released on the way.
+static uint16_t find_key_entry(const mc_resource_table_t *table, int32_t key)
+{
+    uint16_t slot = find_key_slot(table, key);
+    if (slot == MC_RESOURCE_NONE)
+    {
+        return MC_RESOURCE_NONE;
+    }
+    uint16_t entry = table->key_index[slot] - 1;
+    if (table->lease_ms != 0 && is_expired(table, entry, mc_time_get_ms()))
+    {
+        release_slot(table, slot);
+        return MC_RESOURCE_NONE;
+    }
+    return entry;
+}
+
+// Helper: find live entry by handle. Expired entries are released on the way.
+static uint16_t find_handle_entry(const mc_resource_table_t *table,
+                                  mc_resource_handle_t handle)
+{
+    uint16_t entry = (uint16_t)(handle & 0xFFFF);
+    if (entry >= table->count || !table->pool[entry].is_busy ||
+        table->pool[entry].generation != (uint16_t)(handle >> 16))
+    {
+        return MC_RESOURCE_NONE;
+    }
+    if (table->lease_ms != 0 && is_expired(table, entry, mc_time_get_ms()))
+    {
+        release_slot(table, find_key_slot(table, table->pool[entry].key));
+        return MC_RESOURCE_NONE;
+    }
+    return entry;
+}
+
+void mc_resource_table_init(const mc_resource_table_t *table)
+{
+    MC_ASSERT(table != NULL);
+    MC_ASSERT(table->pool != NULL);
+    MC_ASSERT(table->state != NULL);
+    MC_ASSERT(table->count > 0 && table->count < 0x8000);
+    MC_ASSERT(table->index_len > table->count);
+
+    memset(table->key_index, 0, table->index_len * sizeof(uint16_t));
+    memset(table->data_index, 0, table->index_len * sizeof(uint16_t));
+
+    // Chain all entries into the free list, lowest index first.
+    for (uint16_t i = 0; i < table->count; i++)
+    {
+        table->pool[i].is_busy = false;
+        table->pool[i].generation = 0;
+        table->pool[i].next = (i + 1 < table->count) ? i + 1
+                                                     : MC_RESOURCE_NONE;
+        index_insert(table, table->data_index, i, false);
+    }
+    table->state->free_head = 0;
+    table->state->used_count = 0;
+    table->state->sweep_cursor = 0;
+    table->state->is_initialized = MC_INITIALIZED;
+}
+
+// Helper: acquire entry for key. Returns MC_RESOURCE_NONE if full.
+static uint16_t acquire_entry(const mc_resource_table_t *table, int32_t key)
+{
+    // 1. Check if key already exists
+    uint16_t entry = find_key_entry(table, key);
+    if (entry != MC_RESOURCE_NONE)
+    {
+        renew_lease(table, entry);
+        return entry;
+    }
+
+    // 2. Pop the free list. If it is empty, try to reclaim expired leases.
+    if (table->state->free_head == MC_RESOURCE_NONE && table->lease_ms != 0)
+    {
+        mc_resource_table_sweep(table, MC_RESOURCE_TABLE_SWEEP_BUDGET);
+    }
+    entry = table->state->free_head;
+    if (entry == MC_RESOURCE_NONE)
+    {
+        // 3. Pool is full.
+        return MC_RESOURCE_NONE;
+    }
+    table->state->free_head = table->pool[entry].next;
+    table->state->used_count++;
+
+    table->pool[entry].is_busy = true;
+    table->pool[entry].key = key;
+    index_insert(table, table->key_index, entry, true);
+    renew_lease(table, entry);
+    return entry;
+}
+
+void *mc_resource_table_acquire(const mc_resource_table_t *table, int32_t key)
+{
+    CHECK_RESOURCE_TABLE(table);
+    uint16_t entry = acquire_entry(table, key);
+    return entry == MC_RESOURCE_NONE ? NULL : table->pool[entry].data;
+}
+
+void *mc_resource_table_get(const mc_resource_table_t *table, int32_t key)
+{
+    CHECK_RESOURCE_TABLE(table);
+    uint16_t entry = find_key_entry(table, key);
+    return entry == MC_RESOURCE_NONE ? NULL : table->pool[entry].data;
+}
+
+void mc_resource_table_release(const mc_resource_table_t *table, void *data)
+{
+    CHECK_RESOURCE_TABLE(table);
+    uint16_t entry = find_data_entry(table, data);
+    if (entry == MC_RESOURCE_NONE || !table->pool[entry].is_busy)
+    {
+        return;
+    }
+    release_slot(table, find_key_slot(table, table->pool[entry].key));
+}
+
+void mc_resource_table_release_key(const mc_resource_table_t *table,
+                                   int32_t key)
+{
+    CHECK_RESOURCE_TABLE(table);
+    uint16_t slot = find_key_slot(table, key);
+    if (slot != MC_RESOURCE_NONE)
+    {
+        release_slot(table, slot);
+    }
+}
+
+mc_resource_handle_t mc_resource_table_acquire_handle(
+    const mc_resource_table_t *table, int32_t key)
+{
+    CHECK_RESOURCE_TABLE(table);
+    uint16_t entry = acquire_entry(table, key);
+    if (entry == MC_RESOURCE_NONE)
+    {
+        return MC_RESOURCE_INVALID_HANDLE;
+    }
+    return ((uint32_t)table->pool[entry].generation << 16) | entry;
+}
+
+void *mc_resource_table_resolve(const mc_resource_table_t *table,
+                                mc_resource_handle_t handle)
+{
+    CHECK_RESOURCE_TABLE(table);
+    uint16_t entry = find_handle_entry(table, handle);
+    return entry == MC_RESOURCE_NONE ? NULL : table->pool[entry].data;
+}
+
+mc_status_t mc_resource_table_touch(const mc_resource_table_t *table,
+                                    mc_resource_handle_t handle)
+{
+    CHECK_RESOURCE_TABLE(table);
+    uint16_t entry = find_handle_entry(table, handle);
+    if (entry == MC_RESOURCE_NONE)
+    {
+        return MC_ERROR_INVALID_ARGS;
+    }
+    renew_lease(table, entry);
+    return MC_OK;
+}
+
+void mc_resource_table_release_handle(const mc_resource_table_t *table,
+                                      mc_resource_handle_t handle)
+{
+    CHECK_RESOURCE_TABLE(table);
+    uint16_t entry = find_handle_entry(table, handle);
+    if (entry != MC_RESOURCE_NONE)
+    {
+        release_slot(table, find_key_slot(table, table->pool[entry].key));
+    }
+}
+
+uint16_t mc_resource_table_sweep(const mc_resource_table_t *table,
+                                 uint16_t max_entries)
+{
+    CHECK_RESOURCE_TABLE(table);
+    if (table->lease_ms == 0)
+    {
+        return 0;
+    }
+
+    uint32_t now = mc_time_get_ms();
+    uint16_t released = 0;
+    uint16_t cursor = table->state->sweep_cursor;
+    for (uint16_t i = 0; i < max_entries && i < table->count; i++)
+    {
+        if (table->pool[cursor].is_busy && is_expired(table, cursor, now))
+        {
+            release_slot(table, find_key_slot(table, table->pool[cursor].key));
+            released++;
+        }
+        cursor = (cursor + 1 < table->count) ? cursor + 1 : 0;
+    }
+    table->state->sweep_cursor = cursor;
+    return released;
+}
+
+uint16_t mc_resource_table_get_used_count(const mc_resource_table_t *table)
+{
+    CHECK_RESOURCE_TABLE(table);
+    return table->state->used_count;
+}
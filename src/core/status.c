@@ -1,3 +1,5 @@
+#define MC_FILE_ID MC_FILE_ID_STATUS
+
 #include "mc/status.h"
 
 const char *mc_status_to_string(mc_status_t status)
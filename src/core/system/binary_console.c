@@ -0,0 +1,392 @@
+#define MC_FILE_ID MC_FILE_ID_SYS_BINARY_CONSOLE
+
+#include "mc/system/binary_console.h"
+#include "mc/utils.h"
+
+// Helper defines.
+#define BIN_CONSOLE_BATCH_LEN 8
+#define BIN_CONSOLE_HEADER_LEN 3  // REQ_ID, OPCODE, STATUS
+#define BIN_CONSOLE_MAX_ITEMS 127 // Keeps the item count a one byte varint
+
+// Frame parser phases.
+enum
+{
+    RX_PHASE_SYNC = 0,
+    RX_PHASE_LEN,
+    RX_PHASE_PAYLOAD,
+    RX_PHASE_CRC_LOW,
+    RX_PHASE_CRC_HIGH,
+};
+
+// Helper: cursor for reading a payload. ok is cleared on a read past the end
+// or a malformed varint.
+typedef struct bin_reader_t
+{
+    const uint8_t *pos;
+    const uint8_t *end;
+    bool ok;
+} bin_reader_t;
+
+// Helper: cursor for writing a payload. ok is cleared when it does not fit.
+typedef struct bin_writer_t
+{
+    uint8_t *pos;
+    uint8_t *end;
+    bool ok;
+} bin_writer_t;
+
+// Helper: read an unsigned LEB128 varint of up to 32 bits.
+static uint32_t read_varint(bin_reader_t *r)
+{
+    uint32_t val = 0;
+    for (uint8_t shift = 0; shift < 32 && r->pos < r->end; shift += 7)
+    {
+        uint8_t byte = *r->pos++;
+        if (shift == 28 && byte > 0x0F)
+        {
+            break;
+        }
+        val |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+        {
+            return val;
+        }
+    }
+    r->ok = false;
+    return 0;
+}
+
+// Helper: read a member or system ID.
+static mc_sys_id_t read_id(bin_reader_t *r)
+{
+    uint32_t id = read_varint(r);
+    if (id > MC_SYS_MAX_ID)
+    {
+        r->ok = false;
+    }
+    return (mc_sys_id_t)id;
+}
+
+// Helper: read a zigzag encoded value.
+static int32_t read_value(bin_reader_t *r)
+{
+    uint32_t zz = read_varint(r);
+    return (int32_t)((zz >> 1) ^ (0u - (zz & 1)));
+}
+
+// Helper: write one byte.
+static void write_byte(bin_writer_t *w, uint8_t byte)
+{
+    if (w->pos >= w->end)
+    {
+        w->ok = false;
+        return;
+    }
+    *w->pos++ = byte;
+}
+
+// Helper: write an unsigned LEB128 varint.
+static void write_varint(bin_writer_t *w, uint32_t val)
+{
+    while (val >= 0x80)
+    {
+        write_byte(w, (uint8_t)(val | 0x80));
+        val >>= 7;
+    }
+    write_byte(w, (uint8_t)val);
+}
+
+// Helper: write a zigzag encoded value.
+static void write_value(bin_writer_t *w, int32_t val)
+{
+    write_varint(w, ((uint32_t)val << 1) ^ (uint32_t)(val >> 31));
+}
+
+// Helper: Find System by ID. NULL if there is none.
+static const mc_system_t *find_system_by_id(
+    const mc_system_binary_console_t *console, mc_sys_id_t id)
+{
+    const mc_system_entry_t *systems = console->config->systems;
+    // Tables from MC_DEFINE_SYSTEM_REGISTRY have entry i at ID i.
+    if (id < console->config->system_count && systems[id].id == id)
+    {
+        return systems[id].system;
+    }
+    for (uint8_t i = 0; i < console->config->system_count; i++)
+    {
+        if (systems[i].id == id)
+        {
+            return systems[i].system;
+        }
+    }
+    return NULL;
+}
+
+// Helper: write a result as response data, or return its error.
+static mc_status_t write_result(bin_writer_t *w, mc_result_t res)
+{
+    if (!MC_RESULT_IS_OK(res))
+    {
+        return MC_RESULT_ERROR(res);
+    }
+    write_value(w, MC_RESULT_VALUE(res));
+    return MC_OK;
+}
+
+// Helper: answer MC_SYS_BIN_OP_READ_OUTPUTS with as many items as fit.
+static mc_status_t read_outputs(const mc_system_t *sys, mc_sys_id_t first_id,
+                                mc_sys_id_t count, bin_writer_t *w)
+{
+    int32_t values[BIN_CONSOLE_BATCH_LEN];
+    mc_status_t errors[BIN_CONSOLE_BATCH_LEN];
+
+    if (count > BIN_CONSOLE_MAX_ITEMS)
+    {
+        count = BIN_CONSOLE_MAX_ITEMS;
+    }
+
+    // Item count is patched once it is known.
+    uint8_t *count_pos = w->pos;
+    write_byte(w, 0);
+    if (!w->ok)
+    {
+        return MC_ERROR_NO_RESOURCE;
+    }
+
+    uint8_t written = 0;
+    while (w->ok && written < count)
+    {
+        mc_sys_id_t batch = count - written;
+        if (batch > BIN_CONSOLE_BATCH_LEN)
+        {
+            batch = BIN_CONSOLE_BATCH_LEN;
+        }
+        mc_sys_read_outputs(sys, first_id + written, batch, values, errors);
+
+        for (mc_sys_id_t i = 0; i < batch && w->ok; i++)
+        {
+            uint8_t *item_pos = w->pos;
+            write_byte(w, (uint8_t)errors[i]);
+            if (errors[i] == MC_OK)
+            {
+                write_value(w, values[i]);
+            }
+            if (w->ok)
+            {
+                written++;
+            }
+            else
+            {
+                // Payload is full, drop the partial item.
+                w->pos = item_pos;
+            }
+        }
+    }
+    *count_pos = written;
+    w->ok = true;
+    return MC_OK;
+}
+
+// Helper: run one request and write its response data.
+static mc_status_t handle_request(const mc_system_binary_console_t *console,
+                                  uint8_t opcode, bin_reader_t *r,
+                                  bin_writer_t *w)
+{
+    if (opcode == MC_SYS_BIN_OP_PING)
+    {
+        return MC_OK;
+    }
+    if (opcode > MC_SYS_BIN_OP_INVOKE)
+    {
+        return MC_ERROR_NOT_SUPPORTED;
+    }
+
+    const mc_system_t *sys = find_system_by_id(console, read_id(r));
+    mc_sys_id_t id = read_id(r);
+    if (!r->ok || sys == NULL)
+    {
+        return MC_ERROR_INVALID_ARGS;
+    }
+
+    switch (opcode)
+    {
+    case MC_SYS_BIN_OP_READ_INPUT:
+        return write_result(w, mc_sys_read_input(sys, id));
+
+    case MC_SYS_BIN_OP_WRITE_INPUT:
+    {
+        int32_t val = read_value(r);
+        if (!r->ok)
+        {
+            return MC_ERROR_INVALID_ARGS;
+        }
+        return mc_sys_write_input(sys, id, val);
+    }
+
+    case MC_SYS_BIN_OP_READ_OUTPUT:
+        return write_result(w, mc_sys_read_output(sys, id));
+
+    case MC_SYS_BIN_OP_READ_OUTPUTS:
+    {
+        uint32_t count = read_varint(r);
+        if (!r->ok || (uint32_t)id + count > (uint32_t)MC_SYS_MAX_ID + 1)
+        {
+            return MC_ERROR_INVALID_ARGS;
+        }
+        return read_outputs(sys, id, (mc_sys_id_t)count, w);
+    }
+
+    default: // MC_SYS_BIN_OP_INVOKE
+    {
+        // Arguments run to the end of the payload.
+        uint8_t argc = 0;
+        while (r->ok && r->pos < r->end)
+        {
+            if (argc >= console->config->args_count)
+            {
+                return MC_ERROR_INVALID_ARGS;
+            }
+            console->config->args_buffer[argc++] = read_value(r);
+        }
+        if (!r->ok)
+        {
+            return MC_ERROR_INVALID_ARGS;
+        }
+        return mc_sys_invoke(sys, id, console->config->args_buffer, argc);
+    }
+    }
+}
+
+// Helper: run a received request and send the response frame.
+static void process_frame(const mc_system_binary_console_t *console)
+{
+    const uint8_t *payload = console->config->rx_payload;
+    uint8_t len = console->state->rx_len;
+    if (len < 2)
+    {
+        // Not even a request ID and opcode.
+        console->state->dropped_count++;
+        return;
+    }
+
+    uint8_t *frame = console->config->tx_frame;
+    uint8_t *response = frame + 2;
+    response[0] = payload[0];
+    response[1] = payload[1] | MC_SYS_BIN_RESPONSE;
+
+    bin_reader_t r = {.pos = payload + 2, .end = payload + len, .ok = true};
+    bin_writer_t w = {.pos = response + BIN_CONSOLE_HEADER_LEN,
+                      .end = response + MC_SYS_BIN_MAX_PAYLOAD,
+                      .ok = true};
+    mc_status_t status = handle_request(console, payload[1], &r, &w);
+    if (status != MC_OK || !w.ok)
+    {
+        // Errors carry no data.
+        status = status != MC_OK ? status : MC_ERROR_NO_RESOURCE;
+        w.pos = response + BIN_CONSOLE_HEADER_LEN;
+    }
+    response[2] = (uint8_t)status;
+
+    uint8_t response_len = (uint8_t)(w.pos - response);
+    frame[0] = MC_SYS_BIN_SYNC;
+    frame[1] = response_len;
+    uint16_t crc = mc_crc16_update(MC_CRC16_INIT, &frame[1],
+                                   response_len + 1u);
+    w.pos[0] = (uint8_t)crc;
+    w.pos[1] = (uint8_t)(crc >> 8);
+
+    mc_stream_write(console->stream, (const char *)frame,
+                    response_len + MC_SYS_BIN_FRAME_OVERHEAD);
+}
+
+// Helper: feed one received byte to the frame parser.
+static void feed_byte(const mc_system_binary_console_t *console, uint8_t byte)
+{
+    mc_system_binary_console_state_t *state = console->state;
+    switch (state->rx_phase)
+    {
+    case RX_PHASE_SYNC:
+        if (byte == MC_SYS_BIN_SYNC)
+        {
+            state->rx_phase = RX_PHASE_LEN;
+        }
+        break;
+
+    case RX_PHASE_LEN:
+        if (byte > MC_SYS_BIN_MAX_PAYLOAD)
+        {
+            state->dropped_count++;
+            state->rx_phase = RX_PHASE_SYNC;
+            break;
+        }
+        state->rx_len = byte;
+        state->rx_index = 0;
+        state->rx_phase = byte > 0 ? RX_PHASE_PAYLOAD : RX_PHASE_CRC_LOW;
+        break;
+
+    case RX_PHASE_PAYLOAD:
+        console->config->rx_payload[state->rx_index++] = byte;
+        if (state->rx_index == state->rx_len)
+        {
+            state->rx_phase = RX_PHASE_CRC_LOW;
+        }
+        break;
+
+    case RX_PHASE_CRC_LOW:
+        state->rx_crc = byte;
+        state->rx_phase = RX_PHASE_CRC_HIGH;
+        break;
+
+    default: // RX_PHASE_CRC_HIGH
+    {
+        state->rx_crc |= (uint16_t)byte << 8;
+        state->rx_phase = RX_PHASE_SYNC;
+
+        uint16_t crc = mc_crc16_update(MC_CRC16_INIT, &state->rx_len, 1);
+        crc = mc_crc16_update(crc, console->config->rx_payload, state->rx_len);
+        if (crc != state->rx_crc)
+        {
+            state->dropped_count++;
+            break;
+        }
+        process_frame(console);
+        break;
+    }
+    }
+}
+
+// --- Stream Callback Wrapper ---
+static void binary_console_rx_handler(void *ctx, void *data)
+{
+    mc_system_binary_console_t *console = (mc_system_binary_console_t *)ctx;
+    mc_stream_event_data_t *event_data = (mc_stream_event_data_t *)data;
+
+    for (uint16_t i = 0; i < event_data->length; i++)
+    {
+        feed_byte(console, (uint8_t)event_data->message[i]);
+    }
+}
+
+void mc_sys_binary_console_init(const mc_system_binary_console_t *console)
+{
+    MC_ASSERT(console != NULL);
+    MC_ASSERT(console->config->rx_payload != NULL);
+    MC_ASSERT(console->config->tx_frame != NULL);
+    console->state->rx_phase = RX_PHASE_SYNC;
+    console->state->dropped_count = 0;
+    console->state->is_initialized = MC_INITIALIZED;
+
+    // Frames are not lines, so take the raw bytes.
+    mc_stream_set_mode(console->stream, MC_STREAM_MODE_BINARY_STREAM);
+    mc_callback_init(&console->state->rx_callback, binary_console_rx_handler,
+                     (void *)console);
+    mc_stream_register_rx_callback(console->stream, &console->state->rx_callback);
+}
+
+uint16_t mc_sys_binary_console_get_dropped_count(
+    const mc_system_binary_console_t *console)
+{
+    MC_ASSERT(console != NULL);
+    MC_ASSERT(console->state->is_initialized == MC_INITIALIZED);
+    return console->state->dropped_count;
+}
@@ -1,3 +1,5 @@
+#define MC_FILE_ID MC_FILE_ID_SYS_COMPOSITE
+
 #include "mc/system/composite.h"
 #include "mc/utils.h"
 
@@ -17,293 +19,608 @@ static inline void *get_child_ctx(void *parent_ctx,
     return (void *)((char *)parent_ctx + driver->ctx_offsets[index]);
 }
 
-void mc_composite_init(void *ctx, const mc_composite_driver_t *driver)
+// Helper: context of a leaf, any number of levels below ctx.
+static inline void *get_leaf_ctx(void *ctx, const mc_composite_cache_t *table,
+                                 uint8_t index)
 {
-    CHECK_COMPOSITE(ctx, driver);
+    return (void *)((char *)ctx + table->leaves[index].ctx_offset);
+}
+
+// Helper: calls an optional count op, 0 if missing.
+static mc_sys_id_t child_count(mc_sys_id_t (*get_count)(void *ctx), void *ctx)
+{
+    return get_count ? get_count(ctx) : 0;
+}
 
+// Helper: next[kind] = prev[kind] + count, checked against the ID range.
+static void add_count(const mc_sys_id_t *prev, mc_sys_id_t *next,
+                      mc_composite_kind_t kind, mc_sys_id_t count)
+{
+    uint32_t total = (uint32_t)prev[kind] + count;
+    // Members past the ID range, build with MC_SYS_WIDE_IDS=1
+    MC_ASSERT_ALWAYS(total <= MC_SYS_MAX_ID);
+    next[kind] = (mc_sys_id_t)total;
+}
+
+// Helper: appends the leaves of driver, whose ctx is at offset in the root
+// ctx, descending into nested composites.
+static void add_leaves(mc_composite_cache_t *table, void *root_ctx,
+                       const mc_composite_driver_t *driver, size_t offset)
+{
     for (uint8_t i = 0; i < driver->count; i++)
     {
-        const mc_system_driver_t *child_drv = driver->systems[i];
-        void *child_ctx = get_child_ctx(ctx, driver, i);
+        size_t child_offset = offset + driver->ctx_offsets[i];
+        if (driver->nested != NULL && driver->nested[i] != NULL)
+        {
+            add_leaves(table, root_ctx, driver->nested[i], child_offset);
+            continue;
+        }
 
-        // Recursively call init if the child driver has it
-        if (child_drv && child_drv->init)
+        const mc_system_driver_t *d = driver->systems[i];
+        if (d == NULL)
         {
-            child_drv->init(child_ctx);
+            continue;
         }
+        // Too many leaves, raise MC_COMPOSITE_MAX_LEAVES
+        MC_ASSERT_ALWAYS(table->leaf_count < table->capacity);
+
+        uint8_t n = table->leaf_count;
+        void *leaf_ctx = (char *)root_ctx + child_offset;
+        mc_composite_prefix_t *prefix = table->prefix;
+        table->leaves[n].driver = d;
+        table->leaves[n].ctx_offset = child_offset;
+        if (d->counts_changed)
+        {
+            table->has_changing_leaves = true;
+        }
+        add_count(prefix[n], prefix[n + 1], MC_COMPOSITE_FUNCTIONS,
+                  child_count(d->get_function_count, leaf_ctx));
+        add_count(prefix[n], prefix[n + 1], MC_COMPOSITE_INPUTS,
+                  child_count(d->get_input_count, leaf_ctx));
+        add_count(prefix[n], prefix[n + 1], MC_COMPOSITE_OUTPUTS,
+                  child_count(d->get_output_count, leaf_ctx));
+        add_count(prefix[n], prefix[n + 1], MC_COMPOSITE_ALIASES,
+                  child_count(d->get_alias_count, leaf_ctx));
+        table->leaf_count = n + 1;
     }
 }
 
-mc_status_t mc_composite_write_input(void *ctx,
-                                     const mc_composite_driver_t *driver,
-                                     uint8_t id, int32_t val)
+// Helper: hands cache slot i to ctx.
+static mc_composite_cache_t *claim_cache(const mc_composite_driver_t *driver,
+                                         uint8_t i, const void *ctx)
 {
-    CHECK_COMPOSITE(ctx, driver);
+    mc_composite_cache_t *cache = &driver->caches[i];
+    cache->ctx = ctx;
+    cache->leaves = driver->leaves;
+    cache->prefix = &driver->prefix[i * (driver->capacity + 1)];
+    cache->capacity = driver->capacity;
+    cache->is_valid = false;
+    return cache;
+}
 
-    for (uint8_t i = 0; i < driver->count; i++)
+// Helper: cache slot of ctx, claiming a free one on first use.
+static mc_composite_cache_t *get_cache(void *ctx,
+                                       const mc_composite_driver_t *driver)
+{
+    for (uint8_t i = 0; i < driver->cache_count; i++)
     {
-        const mc_system_driver_t *child_drv = driver->systems[i];
-        void *child_ctx = get_child_ctx(ctx, driver, i);
-
-        // Ask the child how many inputs it has
-        uint8_t local_count = 0;
-        if (child_drv->get_input_count)
+        if (driver->caches[i].ctx == ctx)
+        {
+            return &driver->caches[i];
+        }
+        if (driver->caches[i].ctx == NULL)
         {
-            local_count = child_drv->get_input_count(child_ctx);
+            return claim_cache(driver, i, ctx);
         }
+    }
+    // More instances than tables, raise INSTANCES of
+    // MC_DEFINE_COMPOSITE_DRIVER_WITH_INSTANCES
+    MC_ASSERT_ALWAYS(false);
+    return claim_cache(driver, driver->cache_count - 1, ctx);
+}
 
-        // Is the ID meant for this child?
-        if (id < local_count)
+// Helper: whether the table of ctx is missing, invalidated or behind the
+// counts of a leaf.
+static bool is_table_stale(void *ctx, const mc_composite_cache_t *table)
+{
+    if (!table->is_valid || table->generation != mc_sys_get_generation())
+    {
+        return true;
+    }
+    if (!table->has_changing_leaves)
+    {
+        return false;
+    }
+    for (uint8_t i = 0; i < table->leaf_count; i++)
+    {
+        const mc_system_driver_t *d = table->leaves[i].driver;
+        if (d->counts_changed && d->counts_changed(get_leaf_ctx(ctx, table, i)))
         {
-            // Yes! Dispatch to this child using the local ID
-            if (child_drv->write_input)
-            {
-                return child_drv->write_input(child_ctx, id, val);
-            }
-            else
-            {
-                return MC_ERROR_NOT_SUPPORTED;
-            }
+            return true;
         }
+    }
+    return false;
+}
 
-        // No, the ID is for a subsequent child.
-        // Subtract this child's count from the ID and continue.
-        id -= local_count;
+// Helper: leaf table for ctx, rebuilt if stale.
+static mc_composite_cache_t *get_table(void *ctx,
+                                       const mc_composite_driver_t *driver)
+{
+    mc_composite_cache_t *table = get_cache(ctx, driver);
+    if (!is_table_stale(ctx, table))
+    {
+        return table;
     }
 
-    return MC_ERROR_INVALID_ARGS; // ID exceeded total inputs
+    for (uint8_t k = 0; k < MC_COMPOSITE_KIND_COUNT; k++)
+    {
+        table->prefix[0][k] = 0;
+    }
+    table->leaf_count = 0;
+    table->has_changing_leaves = false;
+    add_leaves(table, ctx, driver, 0);
+
+    table->generation = mc_sys_get_generation();
+    table->is_valid = true;
+    return table;
 }
 
-mc_result_t mc_composite_read_input(void *ctx,
-                                    const mc_composite_driver_t *driver,
-                                    uint8_t id)
+// Helper: index of the leaf owning member id of kind, count if id is past the
+// end. Binary search for the last leaf starting at or before id; leaves
+// without members of kind share their start with the next leaf.
+static uint8_t find_child(mc_composite_prefix_t *prefix, uint8_t count,
+                          mc_composite_kind_t kind, mc_sys_id_t id)
 {
-    CHECK_COMPOSITE(ctx, driver);
+    if (id >= prefix[count][kind])
+    {
+        return count;
+    }
 
+    // prefix[lo] <= id < prefix[hi]
+    uint8_t lo = 0;
+    uint8_t hi = count;
+    while (hi - lo > 1)
+    {
+        uint8_t mid = lo + (hi - lo) / 2;
+        if (prefix[mid][kind] <= id)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Helper: initializes the children of driver. Nested composites are part of
+// the root's leaf table, so they are descended into instead of initialized
+// as systems of their own, which would take one of their tables.
+static void init_children(void *ctx, const mc_composite_driver_t *driver)
+{
     for (uint8_t i = 0; i < driver->count; i++)
     {
         const mc_system_driver_t *child_drv = driver->systems[i];
         void *child_ctx = get_child_ctx(ctx, driver, i);
 
-        uint8_t local_count = 0;
-        if (child_drv->get_input_count)
+        if (driver->nested != NULL && driver->nested[i] != NULL)
         {
-            local_count = child_drv->get_input_count(child_ctx);
+            init_children(child_ctx, driver->nested[i]);
         }
-
-        if (id < local_count)
+        // Recursively call init if the child driver has it
+        else if (child_drv && child_drv->init)
         {
-            if (child_drv->read_input)
-            {
-                return child_drv->read_input(child_ctx, id);
-            }
-            else
-            {
-                return MC_ERR_VAL(MC_ERROR_NOT_SUPPORTED);
-            }
+            child_drv->init(child_ctx);
         }
-        id -= local_count;
+    }
+}
+
+void mc_composite_init(void *ctx, const mc_composite_driver_t *driver)
+{
+    CHECK_COMPOSITE(ctx, driver);
+
+    init_children(ctx, driver);
+
+    // Children may change their counts on init.
+    get_cache(ctx, driver)->is_valid = false;
+}
+
+mc_status_t mc_composite_write_input(void *ctx,
+                                     const mc_composite_driver_t *driver,
+                                     mc_sys_id_t id, int32_t val)
+{
+    CHECK_COMPOSITE(ctx, driver);
+
+    mc_composite_cache_t *table = get_table(ctx, driver);
+    mc_composite_prefix_t *prefix = table->prefix;
+    uint8_t i = find_child(prefix, table->leaf_count, MC_COMPOSITE_INPUTS, id);
+    if (i == table->leaf_count)
+    {
+        return MC_ERROR_INVALID_ARGS; // ID exceeded total inputs
     }
 
-    return MC_ERR_VAL(MC_ERROR_INVALID_ARGS);
+    const mc_system_driver_t *child_drv = table->leaves[i].driver;
+    if (!child_drv->write_input)
+    {
+        return MC_ERROR_NOT_SUPPORTED;
+    }
+    return child_drv->write_input(get_leaf_ctx(ctx, table, i),
+                                  id - prefix[i][MC_COMPOSITE_INPUTS], val);
+}
+
+mc_result_t mc_composite_read_input(void *ctx,
+                                    const mc_composite_driver_t *driver,
+                                    mc_sys_id_t id)
+{
+    CHECK_COMPOSITE(ctx, driver);
+
+    mc_composite_cache_t *table = get_table(ctx, driver);
+    mc_composite_prefix_t *prefix = table->prefix;
+    uint8_t i = find_child(prefix, table->leaf_count, MC_COMPOSITE_INPUTS, id);
+    if (i == table->leaf_count)
+    {
+        return MC_ERR_VAL(MC_ERROR_INVALID_ARGS);
+    }
+
+    const mc_system_driver_t *child_drv = table->leaves[i].driver;
+    if (!child_drv->read_input)
+    {
+        return MC_ERR_VAL(MC_ERROR_NOT_SUPPORTED);
+    }
+    return child_drv->read_input(get_leaf_ctx(ctx, table, i),
+                                 id - prefix[i][MC_COMPOSITE_INPUTS]);
 }
 
 mc_result_t mc_composite_read_output(void *ctx,
                                      const mc_composite_driver_t *driver,
-                                     uint8_t id)
+                                     mc_sys_id_t id)
 {
     CHECK_COMPOSITE(ctx, driver);
 
-    for (uint8_t i = 0; i < driver->count; i++)
+    mc_composite_cache_t *table = get_table(ctx, driver);
+    mc_composite_prefix_t *prefix = table->prefix;
+    uint8_t i = find_child(prefix, table->leaf_count, MC_COMPOSITE_OUTPUTS, id);
+    if (i == table->leaf_count)
     {
-        const mc_system_driver_t *child_drv = driver->systems[i];
-        void *child_ctx = get_child_ctx(ctx, driver, i);
+        return MC_ERR_VAL(MC_ERROR_INVALID_ARGS);
+    }
 
-        uint8_t local_count = 0;
-        if (child_drv->get_output_count)
-        {
-            local_count = child_drv->get_output_count(child_ctx);
-        }
+    const mc_system_driver_t *child_drv = table->leaves[i].driver;
+    if (!child_drv->read_output)
+    {
+        return MC_ERR_VAL(MC_ERROR_NOT_SUPPORTED);
+    }
+    return child_drv->read_output(get_leaf_ctx(ctx, table, i),
+                                  id - prefix[i][MC_COMPOSITE_OUTPUTS]);
+}
+
+// Helper: sets errors[from..to) to err. errors may be NULL.
+static void fill_errors(mc_status_t *errors, mc_sys_id_t from, mc_sys_id_t to,
+                        mc_status_t err)
+{
+    for (mc_sys_id_t i = from; errors != NULL && i < to; i++)
+    {
+        errors[i] = err;
+    }
+}
+
+mc_status_t mc_composite_read_outputs(void *ctx,
+                                      const mc_composite_driver_t *driver,
+                                      mc_sys_id_t first_id, mc_sys_id_t count,
+                                      int32_t *values, mc_status_t *errors)
+{
+    CHECK_COMPOSITE(ctx, driver);
 
-        if (id < local_count)
+    // Hand each child the part of the range it owns, in one call.
+    mc_composite_cache_t *table = get_table(ctx, driver);
+    mc_composite_prefix_t *prefix = table->prefix;
+    mc_status_t ret = MC_OK;
+    mc_sys_id_t done = 0;
+    for (uint8_t i = find_child(prefix, table->leaf_count, MC_COMPOSITE_OUTPUTS,
+                                first_id);
+         i < table->leaf_count && done < count; i++)
+    {
+        mc_sys_id_t start = prefix[i][MC_COMPOSITE_OUTPUTS];
+        mc_sys_id_t end = prefix[i + 1][MC_COMPOSITE_OUTPUTS];
+        mc_sys_id_t id = first_id + done;
+        if (id >= end)
         {
-            if (child_drv->read_output)
-            {
-                return child_drv->read_output(child_ctx, id);
-            }
-            else
-            {
-                return MC_ERR_VAL(MC_ERROR_NOT_SUPPORTED);
-            }
+            continue;
         }
-        id -= local_count;
+
+        mc_sys_id_t n = MC_MIN(count - done, end - id);
+        mc_status_t err = mc_sys_driver_read_outputs(
+            table->leaves[i].driver, get_leaf_ctx(ctx, table, i), id - start, n,
+            values + done, errors != NULL ? errors + done : NULL);
+        ret = ret != MC_OK ? ret : err;
+        done += n;
     }
 
-    return MC_ERR_VAL(MC_ERROR_INVALID_ARGS);
+    if (done < count)
+    {
+        fill_errors(errors, done, count, MC_ERROR_INVALID_ARGS);
+        ret = ret != MC_OK ? ret : MC_ERROR_INVALID_ARGS;
+    }
+    return ret;
 }
 
-mc_status_t mc_composite_invoke(void *ctx, const mc_composite_driver_t *driver,
-                                uint8_t id, int32_t *args, uint8_t arg_count)
+mc_status_t mc_composite_write_inputs(void *ctx,
+                                      const mc_composite_driver_t *driver,
+                                      mc_sys_id_t first_id, mc_sys_id_t count,
+                                      const int32_t *values,
+                                      mc_status_t *errors)
 {
     CHECK_COMPOSITE(ctx, driver);
 
-    for (uint8_t i = 0; i < driver->count; i++)
+    mc_composite_cache_t *table = get_table(ctx, driver);
+    mc_composite_prefix_t *prefix = table->prefix;
+    mc_status_t ret = MC_OK;
+    mc_sys_id_t done = 0;
+    for (uint8_t i = find_child(prefix, table->leaf_count, MC_COMPOSITE_INPUTS,
+                                first_id);
+         i < table->leaf_count && done < count; i++)
     {
-        const mc_system_driver_t *child_drv = driver->systems[i];
-        void *child_ctx = get_child_ctx(ctx, driver, i);
-
-        uint8_t local_count = 0;
-        if (child_drv->get_function_count)
+        mc_sys_id_t start = prefix[i][MC_COMPOSITE_INPUTS];
+        mc_sys_id_t end = prefix[i + 1][MC_COMPOSITE_INPUTS];
+        mc_sys_id_t id = first_id + done;
+        if (id >= end)
         {
-            local_count = child_drv->get_function_count(child_ctx);
+            continue;
         }
 
-        if (id < local_count)
+        mc_sys_id_t n = MC_MIN(count - done, end - id);
+        mc_status_t err = mc_sys_driver_write_inputs(
+            table->leaves[i].driver, get_leaf_ctx(ctx, table, i), id - start, n,
+            values + done, errors != NULL ? errors + done : NULL);
+        ret = ret != MC_OK ? ret : err;
+        done += n;
+    }
+
+    if (done < count)
+    {
+        fill_errors(errors, done, count, MC_ERROR_INVALID_ARGS);
+        ret = ret != MC_OK ? ret : MC_ERROR_INVALID_ARGS;
+    }
+    return ret;
+}
+
+// Inputs routed to one child per driver call.
+#define COMPOSITE_COMMIT_BATCH_LEN 8
+
+// Helper: one child commit. idx maps batch entries back to the caller's.
+static mc_status_t commit_child(const mc_system_driver_t *child_drv,
+                                void *child_ctx, uint8_t n,
+                                const mc_sys_id_t *ids, const int32_t *values,
+                                const mc_sys_id_t *idx,
+                                mc_status_t *errors)
+{
+    mc_status_t batch_errors[COMPOSITE_COMMIT_BATCH_LEN];
+    mc_status_t ret = mc_sys_driver_commit_inputs(
+        child_drv, child_ctx, n, ids, values,
+        errors != NULL ? batch_errors : NULL);
+    if (errors != NULL)
+    {
+        for (uint8_t k = 0; k < n; k++)
         {
-            if (child_drv->invoke)
-            {
-                return child_drv->invoke(child_ctx, id, args, arg_count);
-            }
-            else
-            {
-                return MC_ERROR_NOT_SUPPORTED;
-            }
+            errors[idx[k]] = batch_errors[k];
         }
-        id -= local_count;
     }
-
-    return MC_ERROR_INVALID_ARGS;
+    return ret;
 }
 
-mc_status_t mc_composite_get_alias(
-    void *ctx, const mc_composite_driver_t *driver, uint8_t id,
-    mc_sys_cmd_info_t *info)
+mc_status_t mc_composite_commit_inputs(void *ctx,
+                                       const mc_composite_driver_t *driver,
+                                       mc_sys_id_t count,
+                                       const mc_sys_id_t *x_ids,
+                                       const int32_t *values,
+                                       mc_status_t *errors)
 {
     CHECK_COMPOSITE(ctx, driver);
-    uint8_t f_offset = 0;
-    uint8_t x_offset = 0;
-    uint8_t y_offset = 0;
 
-    for (uint8_t i = 0; i < driver->count; i++)
+    // Hand each child its inputs in batches, so it can still coalesce them.
+    mc_composite_cache_t *table = get_table(ctx, driver);
+    mc_composite_prefix_t *prefix = table->prefix;
+    mc_status_t ret = MC_OK;
+    for (uint8_t i = 0; i < table->leaf_count; i++)
     {
-        const mc_system_driver_t *child_drv = driver->systems[i];
-        void *child_ctx = get_child_ctx(ctx, driver, i);
-
-        uint8_t local_count = 0;
-        if (child_drv->get_alias_count)
+        const mc_system_driver_t *child_drv = table->leaves[i].driver;
+        void *child_ctx = get_leaf_ctx(ctx, table, i);
+        mc_sys_id_t start = prefix[i][MC_COMPOSITE_INPUTS];
+        mc_sys_id_t end = prefix[i + 1][MC_COMPOSITE_INPUTS];
+        if (start == end)
         {
-            local_count = child_drv->get_alias_count(child_ctx);
+            continue;
         }
 
-        if (id < local_count)
+        mc_sys_id_t ids[COMPOSITE_COMMIT_BATCH_LEN];
+        int32_t batch_values[COMPOSITE_COMMIT_BATCH_LEN];
+        mc_sys_id_t idx[COMPOSITE_COMMIT_BATCH_LEN];
+        uint8_t n = 0;
+        for (mc_sys_id_t j = 0; j < count; j++)
         {
-            if (child_drv->get_alias)
+            if (x_ids[j] < start || x_ids[j] >= end)
             {
-                mc_status_t result = child_drv->get_alias(child_ctx, id, info);
-                if (info->type == MC_CMD_TYPE_FUNC)
-                {
-                    info->id += f_offset;
-                }
-                else if (info->type == MC_CMD_TYPE_INPUT)
-                {
-                    info->id += x_offset;
-                }
-                else
-                {
-                    info->id += y_offset;
-                }
-                return result;
+                continue;
             }
-            else
+            ids[n] = x_ids[j] - start;
+            batch_values[n] = values[j];
+            idx[n] = j;
+            n++;
+            if (n == COMPOSITE_COMMIT_BATCH_LEN)
             {
-                return MC_ERROR_NOT_SUPPORTED;
+                mc_status_t err = commit_child(child_drv, child_ctx, n, ids,
+                                               batch_values, idx, errors);
+                ret = ret != MC_OK ? ret : err;
+                n = 0;
             }
         }
-        id -= local_count;
-
-        // Increment offsets
-        if (child_drv->get_function_count)
-        {
-            f_offset += child_drv->get_function_count(child_ctx);
-        }
-        if (child_drv->get_input_count)
+        if (n > 0)
         {
-            x_offset += child_drv->get_input_count(child_ctx);
+            mc_status_t err = commit_child(child_drv, child_ctx, n, ids,
+                                           batch_values, idx, errors);
+            ret = ret != MC_OK ? ret : err;
         }
-        if (child_drv->get_output_count)
+    }
+
+    // IDs past all children
+    for (mc_sys_id_t j = 0; j < count; j++)
+    {
+        if (x_ids[j] >= prefix[table->leaf_count][MC_COMPOSITE_INPUTS])
         {
-            y_offset += child_drv->get_output_count(child_ctx);
+            if (errors != NULL)
+            {
+                errors[j] = MC_ERROR_INVALID_ARGS;
+            }
+            ret = ret != MC_OK ? ret : MC_ERROR_INVALID_ARGS;
         }
     }
-
-    return MC_ERROR_INVALID_ARGS;
+    return ret;
 }
 
-// --- Counting Functions ---
-uint8_t mc_composite_get_input_count(void *ctx,
-                                     const mc_composite_driver_t *driver)
+mc_status_t mc_composite_update(void *ctx, const mc_composite_driver_t *driver,
+                                uint32_t dt_ms)
 {
     CHECK_COMPOSITE(ctx, driver);
 
-    uint8_t total = 0;
-    for (uint8_t i = 0; i < driver->count; i++)
+    // Update every leaf, report the first error.
+    mc_composite_cache_t *table = get_table(ctx, driver);
+    mc_status_t ret = MC_OK;
+    for (uint8_t i = 0; i < table->leaf_count; i++)
     {
-        const mc_system_driver_t *d = driver->systems[i];
-        if (d && d->get_input_count)
+        const mc_system_driver_t *leaf_drv = table->leaves[i].driver;
+        if (leaf_drv->update)
         {
-            total += d->get_input_count(get_child_ctx(ctx, driver, i));
+            mc_status_t err =
+                leaf_drv->update(get_leaf_ctx(ctx, table, i), dt_ms);
+            ret = ret != MC_OK ? ret : err;
         }
     }
-    return total;
+    return ret;
 }
 
-uint8_t mc_composite_get_output_count(void *ctx,
-                                      const mc_composite_driver_t *driver)
+bool mc_composite_has_update(void *ctx, const mc_composite_driver_t *driver)
 {
     CHECK_COMPOSITE(ctx, driver);
 
-    uint8_t total = 0;
-    for (uint8_t i = 0; i < driver->count; i++)
+    mc_composite_cache_t *table = get_table(ctx, driver);
+    for (uint8_t i = 0; i < table->leaf_count; i++)
     {
-        const mc_system_driver_t *d = driver->systems[i];
-        if (d && d->get_output_count)
+        if (table->leaves[i].driver->update)
         {
-            total += d->get_output_count(get_child_ctx(ctx, driver, i));
+            return true;
         }
     }
-    return total;
+    return false;
 }
 
-uint8_t mc_composite_get_function_count(void *ctx,
-                                        const mc_composite_driver_t *driver)
+bool mc_composite_counts_changed(void *ctx,
+                                 const mc_composite_driver_t *driver)
 {
     CHECK_COMPOSITE(ctx, driver);
 
-    uint8_t total = 0;
-    for (uint8_t i = 0; i < driver->count; i++)
+    return is_table_stale(ctx, get_cache(ctx, driver));
+}
+
+void mc_composite_invalidate(void *ctx, const mc_composite_driver_t *driver)
+{
+    CHECK_COMPOSITE(ctx, driver);
+
+    get_cache(ctx, driver)->is_valid = false;
+}
+
+mc_status_t mc_composite_invoke(void *ctx, const mc_composite_driver_t *driver,
+                                mc_sys_id_t id, int32_t *args,
+                                uint8_t arg_count)
+{
+    CHECK_COMPOSITE(ctx, driver);
+
+    mc_composite_cache_t *table = get_table(ctx, driver);
+    mc_composite_prefix_t *prefix = table->prefix;
+    uint8_t i = find_child(prefix, table->leaf_count, MC_COMPOSITE_FUNCTIONS, id);
+    if (i == table->leaf_count)
     {
-        const mc_system_driver_t *d = driver->systems[i];
-        if (d && d->get_function_count)
-        {
-            total += d->get_function_count(get_child_ctx(ctx, driver, i));
-        }
+        return MC_ERROR_INVALID_ARGS;
     }
-    return total;
+
+    const mc_system_driver_t *child_drv = table->leaves[i].driver;
+    if (!child_drv->invoke)
+    {
+        return MC_ERROR_NOT_SUPPORTED;
+    }
+    return child_drv->invoke(get_leaf_ctx(ctx, table, i),
+                             id - prefix[i][MC_COMPOSITE_FUNCTIONS], args,
+                             arg_count);
 }
 
-uint8_t mc_composite_get_alias_count(void *ctx,
-                                     const mc_composite_driver_t *driver)
+mc_status_t mc_composite_get_alias(
+    void *ctx, const mc_composite_driver_t *driver, mc_sys_id_t id,
+    mc_sys_cmd_info_t *info)
 {
     CHECK_COMPOSITE(ctx, driver);
 
-    uint8_t total = 0;
-    for (uint8_t i = 0; i < driver->count; i++)
+    mc_composite_cache_t *table = get_table(ctx, driver);
+    mc_composite_prefix_t *prefix = table->prefix;
+    uint8_t i = find_child(prefix, table->leaf_count, MC_COMPOSITE_ALIASES, id);
+    if (i == table->leaf_count)
     {
-        const mc_system_driver_t *d = driver->systems[i];
-        if (d && d->get_alias_count)
-        {
-            total += d->get_alias_count(get_child_ctx(ctx, driver, i));
-        }
+        return MC_ERROR_INVALID_ARGS;
+    }
+
+    const mc_system_driver_t *child_drv = table->leaves[i].driver;
+    if (!child_drv->get_alias)
+    {
+        return MC_ERROR_NOT_SUPPORTED;
+    }
+    mc_status_t result = child_drv->get_alias(
+        get_leaf_ctx(ctx, table, i), id - prefix[i][MC_COMPOSITE_ALIASES],
+        info);
+
+    // Shift the child's member id into the composite's id space
+    if (info->type == MC_CMD_TYPE_FUNC)
+    {
+        info->id += prefix[i][MC_COMPOSITE_FUNCTIONS];
+    }
+    else if (info->type == MC_CMD_TYPE_INPUT)
+    {
+        info->id += prefix[i][MC_COMPOSITE_INPUTS];
     }
-    return total;
-}
\ No newline at end of file
+    else
+    {
+        info->id += prefix[i][MC_COMPOSITE_OUTPUTS];
+    }
+    return result;
+}
+
+// --- Counting Functions ---
+mc_sys_id_t mc_composite_get_input_count(void *ctx,
+                                         const mc_composite_driver_t *driver)
+{
+    CHECK_COMPOSITE(ctx, driver);
+    mc_composite_cache_t *table = get_table(ctx, driver);
+    return table->prefix[table->leaf_count][MC_COMPOSITE_INPUTS];
+}
+
+mc_sys_id_t mc_composite_get_output_count(void *ctx,
+                                          const mc_composite_driver_t *driver)
+{
+    CHECK_COMPOSITE(ctx, driver);
+    mc_composite_cache_t *table = get_table(ctx, driver);
+    return table->prefix[table->leaf_count][MC_COMPOSITE_OUTPUTS];
+}
+
+mc_sys_id_t mc_composite_get_function_count(void *ctx,
+                                            const mc_composite_driver_t *driver)
+{
+    CHECK_COMPOSITE(ctx, driver);
+    mc_composite_cache_t *table = get_table(ctx, driver);
+    return table->prefix[table->leaf_count][MC_COMPOSITE_FUNCTIONS];
+}
+
+mc_sys_id_t mc_composite_get_alias_count(void *ctx,
+                                         const mc_composite_driver_t *driver)
+{
+    CHECK_COMPOSITE(ctx, driver);
+    mc_composite_cache_t *table = get_table(ctx, driver);
+    return table->prefix[table->leaf_count][MC_COMPOSITE_ALIASES];
+}
@@ -1,15 +1,19 @@
+#define MC_FILE_ID MC_FILE_ID_SYS_CONSOLE
+
 #include <stdlib.h>
 #include <ctype.h>
 #include <string.h>
 #include <stdio.h>
 
 #include "mc/system/console.h"
+#include "mc/system/registry.h"
 #include "mc/utils.h"
 
 // Helper defines.
 #define STX "\x02"
 #define ETX "\x03"
 #define SYS_CONSOLE_HELP_CHAR '?'
+#define SYS_CONSOLE_DUMP_BATCH_LEN 8
 
 // Helpers: check if char is delimiter
 static bool is_delimiter(char c)
@@ -65,11 +69,12 @@ static bool parse_member_token(const char *token, mc_sys_cmd_info_t *info)
         return false;
     }
     char *end;
-    info->id = (uint8_t)strtol(token + 1, &end, 10);
-    if (token + 1 == end)
+    long id = strtol(token + 1, &end, 10);
+    if (token + 1 == end || id < 0 || id > MC_SYS_MAX_ID)
     {
         return false;
     }
+    info->id = (mc_sys_id_t)id;
     info->has_preset = false;
     return true;
 }
@@ -91,11 +96,23 @@ static uint16_t get_cmd_length(const char *str)
 
 // Helper: Find System index by ID
 static int find_system_index_by_id(const mc_system_console_t *console,
-                                   uint8_t id)
+                                   mc_sys_id_t id)
 {
-    for (uint8_t i = 0; i < console->config->system_count; i++)
+    const mc_system_console_config_t *config = console->config;
+    if (config->registry != NULL)
+    {
+        const mc_system_entry_t *entry =
+            mc_sys_registry_get(config->registry, id);
+        return entry != NULL ? (int)(entry - config->systems) : -1;
+    }
+    // Tables listed in ID order have entry i at ID i.
+    if (id < config->system_count && config->systems[id].id == id)
+    {
+        return id;
+    }
+    for (uint8_t i = 0; i < config->system_count; i++)
     {
-        uint8_t entry_id = console->config->systems[i].id;
+        mc_sys_id_t entry_id = config->systems[i].id;
         if (entry_id == id)
         {
             return i;
@@ -104,53 +121,205 @@ static int find_system_index_by_id(const mc_system_console_t *console,
     return -1;
 }
 
+// Helper: fills the name index with the names of all systems. Names are part
+// of the const config, so this runs once at init.
+static void build_name_index(const mc_system_console_t *console)
+{
+    const mc_system_console_config_t *config = console->config;
+    mc_sys_console_name_slot_t *index = config->name_index;
+    uint16_t index_len = config->name_index_len;
+    memset(index, 0, index_len * sizeof(mc_sys_console_name_slot_t));
+
+    for (uint8_t i = 0; i < config->system_count; i++)
+    {
+        const char *name = config->systems[i].name;
+        if (name == NULL)
+        {
+            continue;
+        }
+        size_t len = strlen(name);
+        MC_ASSERT(len <= UINT8_MAX);
+
+        uint32_t hash = mc_hash_bytes(name, len);
+        uint16_t slot = hash % index_len;
+        while (index[slot].sys != 0)
+        {
+            slot = (slot + 1) % index_len;
+        }
+        index[slot].tag = (uint16_t)(hash >> 16);
+        index[slot].len = (uint8_t)len;
+        index[slot].sys = i + 1;
+    }
+}
+
 // Helper: Find System ID by Name
 static int find_system_index_by_name(const mc_system_console_t *console,
                                      const char *name, size_t len)
 {
-    for (int i = 0; i < console->config->system_count; i++)
+    const mc_system_console_config_t *config = console->config;
+    if (config->registry != NULL)
+    {
+        const mc_system_entry_t *entry =
+            mc_sys_registry_find(config->registry, name, len);
+        return entry != NULL ? (int)(entry - config->systems) : -1;
+    }
+    if (config->name_index_len == 0)
     {
-        const char *entry_name = console->config->systems[i].name;
-        // Check for exact length match to avoid prefix collisions
-        if (entry_name && strncmp(entry_name, name, len) == 0 &&
-            entry_name[len] == '\0')
+        return -1;
+    }
+
+    // Length and tag rule out most slots before the string compare.
+    const mc_sys_console_name_slot_t *index = config->name_index;
+    uint32_t hash = mc_hash_bytes(name, len);
+    uint16_t slot = hash % config->name_index_len;
+    while (index[slot].sys != 0)
+    {
+        if (index[slot].len == len &&
+            index[slot].tag == (uint16_t)(hash >> 16) &&
+            strncmp(config->systems[index[slot].sys - 1].name, name, len) == 0)
         {
-            return i;
+            return index[slot].sys - 1;
         }
+        slot = (slot + 1) % config->name_index_len;
     }
     return -1;
 }
 
-// Helper: Find command by alias
-static bool find_command_by_alias(const mc_system_t *sys, const char *name,
-                                  size_t len, mc_sys_cmd_info_t *cmd)
+// Helper: check if alias is exactly the first len chars of name.
+static bool alias_matches(const char *alias, const char *name, size_t len)
+{
+    // Check for exact length match to avoid prefix collisions
+    return alias && strncmp(alias, name, len) == 0 && alias[len] == '\0';
+}
+
+// Helper: Find command by alias, linear search
+static bool find_command_by_alias_linear(const mc_system_t *sys,
+                                         const char *name, size_t len,
+                                         mc_sys_cmd_info_t *cmd)
 {
-    uint8_t count = mc_sys_get_alias_count(sys);
-    for (int i = 0; i < count; i++)
+    mc_sys_id_t count = mc_sys_get_alias_count(sys);
+    for (mc_sys_id_t i = 0; i < count; i++)
     {
         mc_status_t ret = mc_sys_get_alias(sys, i, cmd);
-        if (ret != MC_OK)
+        if (ret == MC_OK && alias_matches(cmd->alias, name, len))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Helper: alias hash, salted with the system index so equal aliases of
+// different systems land in different slots.
+static uint32_t alias_hash(uint8_t sys_index, const char *name, size_t len)
+{
+    return mc_hash_bytes(name, len) ^ (sys_index * 2654435761u);
+}
+
+// Helper: fills the alias index with the aliases of all systems. Aliases past
+// half the index length are left to the linear search.
+static void build_alias_index(const mc_system_console_t *console)
+{
+    const mc_system_console_config_t *config = console->config;
+    mc_sys_console_alias_slot_t *index = config->alias_index;
+    uint16_t index_len = config->alias_index_len;
+    memset(index, 0, index_len * sizeof(mc_sys_console_alias_slot_t));
+
+    uint16_t used = 0;
+    bool is_complete = true;
+    for (uint8_t s = 0; s < config->system_count; s++)
+    {
+        const mc_system_t *sys = config->systems[s].system;
+        if (sys == NULL)
         {
             continue;
         }
 
-        const char *entry_name = cmd->alias;
-        // Check for exact length match to avoid prefix collisions
-        if (entry_name && strncmp(entry_name, name, len) == 0 &&
-            entry_name[len] == '\0')
+        mc_sys_id_t count = mc_sys_get_alias_count(sys);
+        mc_sys_cmd_info_t cmd;
+        for (mc_sys_id_t i = 0; i < count; i++)
+        {
+            if (mc_sys_get_alias(sys, i, &cmd) != MC_OK || cmd.alias == NULL)
+            {
+                continue;
+            }
+            if (used >= index_len / 2)
+            {
+                is_complete = false;
+                break;
+            }
+
+            uint32_t hash = alias_hash(s, cmd.alias, strlen(cmd.alias));
+            uint16_t slot = hash % index_len;
+            while (index[slot].sys != 0)
+            {
+                slot = (slot + 1) % index_len;
+            }
+            index[slot].tag = (uint16_t)(hash >> 16);
+            index[slot].sys = s + 1;
+            index[slot].id = i;
+            used++;
+        }
+    }
+
+    console->state->alias_generation = mc_sys_get_generation();
+    console->state->is_alias_index_valid = true;
+    console->state->is_alias_index_complete = is_complete;
+}
+
+// Helper: Find command by alias of the system at sys_index. One string
+// compare through the index, the linear search is only needed for aliases
+// that did not fit or were renamed since the index was built.
+static bool find_command_by_alias(const mc_system_console_t *console,
+                                  uint8_t sys_index, const char *name,
+                                  size_t len, mc_sys_cmd_info_t *cmd)
+{
+    const mc_system_console_config_t *config = console->config;
+    mc_system_console_state_t *state = console->state;
+    const mc_system_t *sys = config->systems[sys_index].system;
+
+    // Alias counts may have changed since the build.
+    if (!state->is_alias_index_valid ||
+        state->alias_generation != mc_sys_get_generation())
+    {
+        build_alias_index(console);
+    }
+
+    const mc_sys_console_alias_slot_t *index = config->alias_index;
+    uint16_t index_len = config->alias_index_len;
+    uint32_t hash = alias_hash(sys_index, name, len);
+    uint16_t slot = hash % index_len;
+    while (index[slot].sys != 0)
+    {
+        if (index[slot].sys == sys_index + 1 &&
+            index[slot].tag == (uint16_t)(hash >> 16) &&
+            mc_sys_get_alias(sys, index[slot].id, cmd) == MC_OK &&
+            alias_matches(cmd->alias, name, len))
         {
             return true;
         }
+        slot = (slot + 1) % index_len;
     }
-    return false;
+
+    if (!find_command_by_alias_linear(sys, name, len, cmd))
+    {
+        return false;
+    }
+    // Found an alias a complete index misses, so it is stale.
+    if (state->is_alias_index_complete)
+    {
+        state->is_alias_index_valid = false;
+    }
+    return true;
 }
 
 // Helper: simply prints value if OK, "E[code]" if error.
 static mc_status_t send_result(const mc_system_console_t *console,
                                mc_result_t result)
 {
-    int32_t val = result.ok ? result.value : result.error;
-    if (!result.ok)
+    int32_t val = MC_RESULT_IS_OK(result) ? MC_RESULT_VALUE(result)
+                                          : (int32_t)MC_RESULT_ERROR(result);
+    if (!MC_RESULT_IS_OK(result))
     {
         MC_RETURN_IF_ERROR(mc_stream_write(console->stream, "E", 1));
     }
@@ -182,6 +351,30 @@ static mc_status_t send_response(const mc_system_console_t *console,
     return MC_OK;
 }
 
+// Helper: sends header_count outputs of a system, read in batches.
+static mc_status_t send_output_row(const mc_system_console_t *console,
+                                   const mc_system_t *sys)
+{
+    int32_t values[SYS_CONSOLE_DUMP_BATCH_LEN];
+    mc_status_t errors[SYS_CONSOLE_DUMP_BATCH_LEN];
+    uint8_t header_count = console->config->header_count;
+
+    for (uint16_t first = 0; first < header_count;
+         first += SYS_CONSOLE_DUMP_BATCH_LEN)
+    {
+        uint8_t len = MC_MIN(SYS_CONSOLE_DUMP_BATCH_LEN, header_count - first);
+        mc_sys_read_outputs(sys, first, len, values, errors);
+        for (uint8_t i = 0; i < len; i++)
+        {
+            MC_RETURN_IF_ERROR(mc_stream_write(console->stream, "\t", 1));
+            MC_RETURN_IF_ERROR(send_result(
+                console, errors[i] == MC_OK ? MC_OK_VAL(values[i])
+                                            : MC_ERR_VAL(errors[i])));
+        }
+    }
+    return MC_OK;
+}
+
 // Helper: Send System Dump (TSV)
 // Triggered when user types just the system name/ID (e.g. "s0", "led1")
 static mc_status_t send_system_dump(
@@ -221,19 +414,78 @@ static mc_status_t send_system_dump(
         MC_RETURN_IF_ERROR(mc_stream_write(console->stream, "\n", 1));
 
         MC_RETURN_IF_ERROR(mc_stream_printf(console->stream, "s%d.y", sys.id));
-        for (int i = 0; i < console->config->header_count; i++)
+        MC_RETURN_IF_ERROR(send_output_row(console, sys.system));
+        MC_RETURN_IF_ERROR(mc_stream_write(console->stream, "\n", 1));
+    }
+
+    // End Frame
+    MC_RETURN_IF_ERROR(mc_stream_write(console->stream, ETX, 1));
+    return MC_OK;
+}
+
+#if MC_EVENT_PROFILING
+// Helper: Send Event Profile (TSV)
+// One row per event with its trigger count, then one row per callback.
+static mc_status_t send_profile_dump(const mc_system_console_t *console,
+                                     const char *cmd_echo)
+{
+    MC_RETURN_IF_ERROR(mc_stream_write(console->stream, STX, 1));
+    MC_RETURN_IF_ERROR(mc_stream_write(console->stream, "\n", 1));
+
+    // Echo the command, if it exists (trimmed)
+    uint8_t len = get_cmd_length(cmd_echo);
+    if (len)
+    {
+        MC_RETURN_IF_ERROR(mc_stream_write(console->stream, cmd_echo, len));
+        MC_RETURN_IF_ERROR(mc_stream_write(console->stream, "\n", 1));
+    }
+
+    // Header Row
+    MC_RETURN_IF_ERROR(mc_stream_printf(
+        console->stream, "event\tcb\tcalls\tmin_us\tavg_us\tmax_us\n"));
+
+    int event_index = 0;
+    mc_node_t *event_node;
+    MC_LIST_FOR_EACH(event_node, mc_event_profile_get_events())
+    {
+        mc_event_t *event = MC_LIST_ENTRY(event_node, mc_event_t, profile_node);
+
+        // Event Row: "rx\t-\t12"
+        if (event->name)
         {
-            MC_RETURN_IF_ERROR(mc_stream_write(console->stream, "\t", 1));
-            mc_result_t res = mc_sys_read_output(sys.system, i);
-            MC_RETURN_IF_ERROR(send_result(console, res));
+            MC_RETURN_IF_ERROR(mc_stream_printf(console->stream, "%s",
+                                                event->name));
         }
-        MC_RETURN_IF_ERROR(mc_stream_write(console->stream, "\n", 1));
+        else
+        {
+            MC_RETURN_IF_ERROR(mc_stream_printf(console->stream, "e%d",
+                                                event_index));
+        }
+        MC_RETURN_IF_ERROR(mc_stream_printf(
+            console->stream, "\t-\t%lu\n",
+            (unsigned long)mc_event_get_trigger_count(event)));
+
+        // Callback Rows: "\t0\t12\t3\t5\t9"
+        int cb_index = 0;
+        mc_node_t *cb_node;
+        MC_LIST_FOR_EACH(cb_node, &event->listeners)
+        {
+            mc_callback_t *cb = MC_LIST_ENTRY(cb_node, mc_callback_t, node);
+            MC_RETURN_IF_ERROR(mc_stream_printf(
+                console->stream, "\t%d\t%lu\t%lu\t%lu\t%lu\n", cb_index++,
+                (unsigned long)cb->stats.call_count,
+                (unsigned long)cb->stats.min_us,
+                (unsigned long)mc_callback_get_avg_us(cb),
+                (unsigned long)cb->stats.max_us));
+        }
+        event_index++;
     }
 
     // End Frame
     MC_RETURN_IF_ERROR(mc_stream_write(console->stream, ETX, 1));
     return MC_OK;
 }
+#endif
 
 // Helper: send alias info of system
 mc_status_t send_sys_help(const mc_system_console_t *console, const char *cmd_echo,
@@ -267,14 +519,14 @@ mc_status_t send_sys_help(const mc_system_console_t *console, const char *cmd_ec
     }
     MC_RETURN_IF_ERROR(mc_stream_printf(console->stream, "[s%d]\n", sys.id));
 
-    uint8_t count = 0;
+    mc_sys_id_t count = 0;
     if (sys.system->driver->get_alias_count)
     {
         count = sys.system->driver->get_alias_count(sys.system->ctx);
     }
 
     mc_sys_cmd_info_t cmd;
-    for (uint8_t i = 0; i < count; i++)
+    for (mc_sys_id_t i = 0; i < count; i++)
     {
         MC_RETURN_IF_ERROR(mc_stream_printf(console->stream, "- "));
         sys.system->driver->get_alias(sys.system->ctx, i, &cmd);
@@ -328,6 +580,14 @@ mc_status_t process_command(const mc_system_console_t *console, const char *cmd)
         return mc_stream_printf(console->stream, "\x1B[2J\x1B[H");
     }
 
+#if MC_EVENT_PROFILING
+    // --- CHECK 2: "prof" command ---
+    if (strncmp(token, "prof", 4) == 0)
+    {
+        return send_profile_dump(console, cmd_start);
+    }
+#endif
+
     // Special corner case: if ? comes right after before system token
     bool is_help = (*token == SYS_CONSOLE_HELP_CHAR);
     if (is_help)
@@ -355,7 +615,7 @@ mc_status_t process_command(const mc_system_console_t *console, const char *cmd)
     if (*token == 's' && isdigit((unsigned char)token[1]))
     {
         long sys_id = strtol(token + 1, &end, 10);
-        if (token + 1 == end)
+        if (token + 1 == end || sys_id < 0 || sys_id > MC_SYS_MAX_ID)
         {
             return send_response(console, cmd_start,
                                  MC_ERR_VAL(MC_ERROR_INVALID_ARGS));
@@ -400,7 +660,8 @@ mc_status_t process_command(const mc_system_console_t *console, const char *cmd)
     bool found_custom = false;
 
     // A. Check Driver Custom Commands ("turnOn", "pwm")
-    found_custom = find_command_by_alias(sys, token, token_len, &cmd_info);
+    found_custom = find_command_by_alias(console, sys_index, token, token_len,
+                                         &cmd_info);
 
     // B. If not custom, fallback to standard "x0", "y1", "f2"
     if (!found_custom && !parse_member_token(token, &cmd_info))
@@ -413,7 +674,7 @@ mc_status_t process_command(const mc_system_console_t *console, const char *cmd)
     token = skip_delimiters(token_end);
 
     // --- STEP 3: Execute ---
-    mc_result_t res;
+    mc_result_t res = MC_ERR_VAL(MC_ERROR_INVALID_ARGS);
     // CASE: INPUT (x)
     if (cmd_info.type == MC_CMD_TYPE_INPUT)
     {
@@ -489,6 +750,23 @@ static void console_rx_handler(void *ctx, void *data)
 void mc_sys_console_init(const mc_system_console_t *console)
 {
     MC_ASSERT(console != NULL);
+    MC_ASSERT(console->config->alias_index != NULL);
+    MC_ASSERT(console->config->alias_index_len > 0);
+    // Entries found through the registry must be the console's own.
+    MC_ASSERT(console->config->registry == NULL ||
+              (console->config->registry->entries == console->config->systems &&
+               console->config->registry->count ==
+                   console->config->system_count));
+    if (console->config->registry == NULL)
+    {
+        // Probing needs a free slot.
+        MC_ASSERT(console->config->system_count == 0 ||
+                  (console->config->name_index != NULL &&
+                   console->config->name_index_len >
+                       console->config->system_count));
+        build_name_index(console);
+    }
+    console->state->is_alias_index_valid = false;
     console->state->is_initialized = MC_INITIALIZED;
 
     // Register Stream Callback
@@ -508,3 +786,14 @@ mc_status_t mc_sys_console_dump(const mc_system_console_t *console,
 
     return send_system_dump(console, NULL, systems, sys_count);
 }
+
+#if MC_EVENT_PROFILING
+/* Dump event profile */
+mc_status_t mc_sys_console_dump_profile(const mc_system_console_t *console)
+{
+    MC_ASSERT(console != NULL);
+    MC_ASSERT(console->state->is_initialized == MC_INITIALIZED);
+
+    return send_profile_dump(console, NULL);
+}
+#endif
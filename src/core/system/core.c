@@ -1,3 +1,5 @@
+#define MC_FILE_ID MC_FILE_ID_SYS_CORE
+
 #include "mc/system/core.h"
 #include "mc/status.h"
 #include "mc/utils.h"
@@ -7,8 +9,70 @@
     {                                                            \
         MC_ASSERT(sys != NULL);                                  \
         MC_ASSERT(sys->state->is_initialized == MC_INITIALIZED); \
+        refresh_if_stale(sys);                                   \
     } while (0)
 
+// Bumped to make every system refresh its cached counts.
+static uint32_t generation_ = 0;
+
+// Helper: calls an optional count op, 0 if missing.
+static mc_sys_id_t driver_count(mc_sys_id_t (*get_count)(void *ctx), void *ctx)
+{
+    return get_count ? get_count(ctx) : 0;
+}
+
+// Helper: caches member counts and capabilities from the driver.
+static void refresh(const mc_system_t *sys)
+{
+    const mc_system_driver_t *drv = sys->driver;
+    mc_system_state_t *state = sys->state;
+
+    state->function_count = driver_count(drv->get_function_count, sys->ctx);
+    state->input_count = driver_count(drv->get_input_count, sys->ctx);
+    state->output_count = driver_count(drv->get_output_count, sys->ctx);
+    state->alias_count = driver_count(drv->get_alias_count, sys->ctx);
+
+    uint8_t caps = 0;
+    if (drv->invoke && drv->get_function_count)
+    {
+        caps |= MC_SYS_CAP_INVOKE;
+    }
+    if (drv->write_input && drv->get_input_count)
+    {
+        caps |= MC_SYS_CAP_WRITE_INPUT;
+    }
+    if (drv->read_input && drv->get_input_count)
+    {
+        caps |= MC_SYS_CAP_READ_INPUT;
+    }
+    if (drv->read_output && drv->get_output_count)
+    {
+        caps |= MC_SYS_CAP_READ_OUTPUT;
+    }
+    if (drv->get_alias && drv->get_alias_count)
+    {
+        caps |= MC_SYS_CAP_GET_ALIAS;
+    }
+    if (drv->update && (!drv->has_update || drv->has_update(sys->ctx)))
+    {
+        caps |= MC_SYS_CAP_UPDATE;
+    }
+    state->capabilities = caps;
+    state->generation = generation_;
+    state->is_stale = false;
+}
+
+// Helper: refreshes the cache if it was invalidated or the counts changed.
+static inline void refresh_if_stale(const mc_system_t *sys)
+{
+    const mc_system_driver_t *drv = sys->driver;
+    if (sys->state->is_stale || sys->state->generation != generation_ ||
+        (drv->counts_changed && drv->counts_changed(sys->ctx)))
+    {
+        refresh(sys);
+    }
+}
+
 void mc_sys_init(const mc_system_t *sys)
 {
     MC_ASSERT(sys != NULL);
@@ -19,10 +83,38 @@ void mc_sys_init(const mc_system_t *sys)
     {
         sys->driver->init(sys->ctx);
     }
+    refresh(sys);
     sys->state->is_initialized = MC_INITIALIZED;
 }
 
-mc_status_t mc_sys_invoke(const mc_system_t *sys, uint8_t func_id,
+void mc_sys_invalidate(const mc_system_t *sys)
+{
+    MC_ASSERT(sys != NULL);
+    MC_ASSERT(sys->state != NULL);
+    sys->state->is_stale = true;
+    if (sys->driver->invalidate)
+    {
+        sys->driver->invalidate(sys->ctx);
+    }
+}
+
+void mc_sys_invalidate_all(void)
+{
+    generation_++;
+}
+
+uint32_t mc_sys_get_generation(void)
+{
+    return generation_;
+}
+
+uint8_t mc_sys_get_capabilities(const mc_system_t *sys)
+{
+    CHECK_SYSTEM(sys);
+    return sys->state->capabilities;
+}
+
+mc_status_t mc_sys_invoke(const mc_system_t *sys, mc_sys_id_t func_id,
                           int32_t *args, uint8_t arg_count)
 {
     CHECK_SYSTEM(sys);
@@ -32,120 +124,326 @@ mc_status_t mc_sys_invoke(const mc_system_t *sys, uint8_t func_id,
     {
         MC_ASSERT(args != NULL);
     }
-    if (!sys->driver->invoke || !sys->driver->get_function_count)
+    if (!(sys->state->capabilities & MC_SYS_CAP_INVOKE))
     {
         return MC_ERROR_NOT_SUPPORTED;
     }
-    if (func_id >= mc_sys_get_function_count(sys))
+    if (func_id >= sys->state->function_count)
     {
         return MC_ERROR_INVALID_ARGS;
     }
     return sys->driver->invoke(sys->ctx, func_id, args, arg_count);
 }
 
-mc_status_t mc_sys_write_input(const mc_system_t *sys, uint8_t x_id,
+mc_status_t mc_sys_write_input(const mc_system_t *sys, mc_sys_id_t x_id,
                                int32_t val)
 {
     CHECK_SYSTEM(sys);
 
-    if (!sys->driver->write_input || !sys->driver->get_input_count)
+    if (!(sys->state->capabilities & MC_SYS_CAP_WRITE_INPUT))
     {
         return MC_ERROR_NOT_SUPPORTED;
     }
-    if (x_id >= mc_sys_get_input_count(sys))
+    if (x_id >= sys->state->input_count)
     {
         return MC_ERROR_INVALID_ARGS;
     }
     return sys->driver->write_input(sys->ctx, x_id, val);
 }
 
-mc_result_t mc_sys_read_input(const mc_system_t *sys, uint8_t x_id)
+mc_result_t mc_sys_read_input(const mc_system_t *sys, mc_sys_id_t x_id)
 {
     CHECK_SYSTEM(sys);
 
-    if (!sys->driver->read_input || !sys->driver->get_input_count)
+    if (!(sys->state->capabilities & MC_SYS_CAP_READ_INPUT))
     {
         return MC_ERR_VAL(MC_ERROR_NOT_SUPPORTED);
     }
-    if (x_id >= mc_sys_get_input_count(sys))
+    if (x_id >= sys->state->input_count)
     {
         return MC_ERR_VAL(MC_ERROR_INVALID_ARGS);
     }
     return sys->driver->read_input(sys->ctx, x_id);
 }
 
-mc_result_t mc_sys_read_output(const mc_system_t *sys, uint8_t y_id)
+mc_result_t mc_sys_read_output(const mc_system_t *sys, mc_sys_id_t y_id)
 {
     CHECK_SYSTEM(sys);
 
-    if (!sys->driver->read_output || !sys->driver->get_output_count)
+    if (!(sys->state->capabilities & MC_SYS_CAP_READ_OUTPUT))
     {
         return MC_ERR_VAL(MC_ERROR_NOT_SUPPORTED);
     }
-    if (y_id >= mc_sys_get_output_count(sys))
+    if (y_id >= sys->state->output_count)
     {
         return MC_ERR_VAL(MC_ERROR_INVALID_ARGS);
     }
     return sys->driver->read_output(sys->ctx, y_id);
 }
 
-mc_status_t mc_sys_get_alias(const mc_system_t *sys, uint8_t id,
-                             mc_sys_cmd_info_t *info)
+mc_status_t mc_sys_update(const mc_system_t *sys, uint32_t dt_ms)
 {
     CHECK_SYSTEM(sys);
-    MC_ASSERT(info != NULL);
 
-    if (!sys->driver->get_alias || !sys->driver->get_alias_count)
+    if (!(sys->state->capabilities & MC_SYS_CAP_UPDATE))
     {
         return MC_ERROR_NOT_SUPPORTED;
     }
-    if (id >= mc_sys_get_alias_count(sys))
+    return sys->driver->update(sys->ctx, dt_ms);
+}
+
+// Helper: sets errors[from..to) to err. errors may be NULL.
+static void fill_errors(mc_status_t *errors, mc_sys_id_t from, mc_sys_id_t to,
+                        mc_status_t err)
+{
+    if (errors == NULL)
     {
-        return MC_ERROR_INVALID_ARGS;
+        return;
     }
-    return sys->driver->get_alias(sys->ctx, id, info);
+    for (mc_sys_id_t i = from; i < to; i++)
+    {
+        errors[i] = err;
+    }
+}
+
+// Helper: number of members from first_id on that exist, at most count.
+static mc_sys_id_t clamp_range(mc_sys_id_t first_id, mc_sys_id_t count,
+                               mc_sys_id_t total)
+{
+    return first_id < total ? MC_MIN(count, total - first_id) : 0;
 }
 
-uint8_t mc_sys_get_function_count(const mc_system_t *sys)
+mc_status_t mc_sys_read_outputs(const mc_system_t *sys, mc_sys_id_t first_id,
+                                mc_sys_id_t count, int32_t *out_values,
+                                mc_status_t *out_errors)
 {
     CHECK_SYSTEM(sys);
+    MC_ASSERT(out_values != NULL);
+
+    if (!(sys->state->capabilities & MC_SYS_CAP_READ_OUTPUT))
+    {
+        fill_errors(out_errors, 0, count, MC_ERROR_NOT_SUPPORTED);
+        return MC_ERROR_NOT_SUPPORTED;
+    }
 
-    if (!sys->driver->get_function_count)
+    // Outputs past the end report invalid args, like mc_sys_read_output.
+    mc_sys_id_t valid = clamp_range(first_id, count, sys->state->output_count);
+    mc_status_t ret = MC_OK;
+    if (valid > 0)
+    {
+        ret = mc_sys_driver_read_outputs(sys->driver, sys->ctx, first_id,
+                                         valid, out_values, out_errors);
+    }
+    if (valid < count)
     {
-        return 0;
+        fill_errors(out_errors, valid, count, MC_ERROR_INVALID_ARGS);
+        ret = ret != MC_OK ? ret : MC_ERROR_INVALID_ARGS;
     }
-    return sys->driver->get_function_count(sys->ctx);
+    return ret;
 }
 
-uint8_t mc_sys_get_input_count(const mc_system_t *sys)
+mc_status_t mc_sys_write_inputs(const mc_system_t *sys, mc_sys_id_t first_id,
+                                mc_sys_id_t count, const int32_t *values,
+                                mc_status_t *out_errors)
 {
     CHECK_SYSTEM(sys);
+    MC_ASSERT(values != NULL);
+
+    if (!(sys->state->capabilities & MC_SYS_CAP_WRITE_INPUT))
+    {
+        fill_errors(out_errors, 0, count, MC_ERROR_NOT_SUPPORTED);
+        return MC_ERROR_NOT_SUPPORTED;
+    }
 
-    if (!sys->driver->get_input_count)
+    mc_sys_id_t valid = clamp_range(first_id, count, sys->state->input_count);
+    mc_status_t ret = MC_OK;
+    if (valid > 0)
     {
-        return 0;
+        ret = mc_sys_driver_write_inputs(sys->driver, sys->ctx, first_id,
+                                         valid, values, out_errors);
     }
-    return sys->driver->get_input_count(sys->ctx);
+    if (valid < count)
+    {
+        fill_errors(out_errors, valid, count, MC_ERROR_INVALID_ARGS);
+        ret = ret != MC_OK ? ret : MC_ERROR_INVALID_ARGS;
+    }
+    return ret;
 }
 
-uint8_t mc_sys_get_output_count(const mc_system_t *sys)
+mc_status_t mc_sys_commit_inputs(const mc_system_t *sys, mc_sys_id_t count,
+                                 const mc_sys_id_t *x_ids,
+                                 const int32_t *values,
+                                 mc_status_t *out_errors)
 {
     CHECK_SYSTEM(sys);
+    MC_ASSERT(x_ids != NULL);
+    MC_ASSERT(values != NULL);
+
+    if (!(sys->state->capabilities & MC_SYS_CAP_WRITE_INPUT))
+    {
+        fill_errors(out_errors, 0, count, MC_ERROR_NOT_SUPPORTED);
+        return MC_ERROR_NOT_SUPPORTED;
+    }
+
+    // Reject the whole batch if any id is out of range, so the driver never
+    // sees part of it.
+    for (mc_sys_id_t i = 0; i < count; i++)
+    {
+        if (x_ids[i] >= sys->state->input_count)
+        {
+            fill_errors(out_errors, 0, count, MC_ERROR_INVALID_ARGS);
+            return MC_ERROR_INVALID_ARGS;
+        }
+    }
+    if (count == 0)
+    {
+        return MC_OK;
+    }
+    return mc_sys_driver_commit_inputs(sys->driver, sys->ctx, count, x_ids,
+                                       values, out_errors);
+}
+
+mc_status_t mc_sys_driver_read_outputs(const mc_system_driver_t *driver,
+                                       void *ctx, mc_sys_id_t first_id,
+                                       mc_sys_id_t count, int32_t *values,
+                                       mc_status_t *errors)
+{
+    MC_ASSERT(driver != NULL);
+    MC_ASSERT(values != NULL);
+
+    if (driver->read_outputs)
+    {
+        return driver->read_outputs(ctx, first_id, count, values, errors);
+    }
+    if (!driver->read_output)
+    {
+        fill_errors(errors, 0, count, MC_ERROR_NOT_SUPPORTED);
+        return MC_ERROR_NOT_SUPPORTED;
+    }
+
+    mc_status_t ret = MC_OK;
+    for (mc_sys_id_t i = 0; i < count; i++)
+    {
+        mc_result_t res = driver->read_output(ctx, first_id + i);
+        mc_status_t err = MC_OK;
+        if (MC_RESULT_IS_OK(res))
+        {
+            values[i] = MC_RESULT_VALUE(res);
+        }
+        else
+        {
+            err = MC_RESULT_ERROR(res);
+            ret = ret != MC_OK ? ret : err;
+        }
+        if (errors != NULL)
+        {
+            errors[i] = err;
+        }
+    }
+    return ret;
+}
+
+mc_status_t mc_sys_driver_write_inputs(const mc_system_driver_t *driver,
+                                       void *ctx, mc_sys_id_t first_id,
+                                       mc_sys_id_t count, const int32_t *values,
+                                       mc_status_t *errors)
+{
+    MC_ASSERT(driver != NULL);
+    MC_ASSERT(values != NULL);
+
+    if (driver->write_inputs)
+    {
+        return driver->write_inputs(ctx, first_id, count, values, errors);
+    }
+    if (!driver->write_input)
+    {
+        fill_errors(errors, 0, count, MC_ERROR_NOT_SUPPORTED);
+        return MC_ERROR_NOT_SUPPORTED;
+    }
+
+    mc_status_t ret = MC_OK;
+    for (mc_sys_id_t i = 0; i < count; i++)
+    {
+        mc_status_t err = driver->write_input(ctx, first_id + i, values[i]);
+        ret = ret != MC_OK ? ret : err;
+        if (errors != NULL)
+        {
+            errors[i] = err;
+        }
+    }
+    return ret;
+}
 
-    if (!sys->driver->get_output_count)
+mc_status_t mc_sys_driver_commit_inputs(const mc_system_driver_t *driver,
+                                        void *ctx, mc_sys_id_t count,
+                                        const mc_sys_id_t *x_ids,
+                                        const int32_t *values,
+                                        mc_status_t *errors)
+{
+    MC_ASSERT(driver != NULL);
+    MC_ASSERT(x_ids != NULL);
+    MC_ASSERT(values != NULL);
+
+    if (driver->commit_inputs)
     {
-        return 0;
+        return driver->commit_inputs(ctx, count, x_ids, values, errors);
     }
-    return sys->driver->get_output_count(sys->ctx);
+    if (!driver->write_input)
+    {
+        fill_errors(errors, 0, count, MC_ERROR_NOT_SUPPORTED);
+        return MC_ERROR_NOT_SUPPORTED;
+    }
+
+    mc_status_t ret = MC_OK;
+    for (mc_sys_id_t i = 0; i < count; i++)
+    {
+        mc_status_t err = driver->write_input(ctx, x_ids[i], values[i]);
+        ret = ret != MC_OK ? ret : err;
+        if (errors != NULL)
+        {
+            errors[i] = err;
+        }
+    }
+    return ret;
 }
 
-uint8_t mc_sys_get_alias_count(const mc_system_t *sys)
+mc_status_t mc_sys_get_alias(const mc_system_t *sys, mc_sys_id_t id,
+                             mc_sys_cmd_info_t *info)
 {
     CHECK_SYSTEM(sys);
+    MC_ASSERT(info != NULL);
 
-    if (!sys->driver->get_alias_count)
+    if (!(sys->state->capabilities & MC_SYS_CAP_GET_ALIAS))
+    {
+        return MC_ERROR_NOT_SUPPORTED;
+    }
+    if (id >= sys->state->alias_count)
     {
-        return 0;
+        return MC_ERROR_INVALID_ARGS;
     }
-    return sys->driver->get_alias_count(sys->ctx);
+    return sys->driver->get_alias(sys->ctx, id, info);
+}
+
+mc_sys_id_t mc_sys_get_function_count(const mc_system_t *sys)
+{
+    CHECK_SYSTEM(sys);
+    return sys->state->function_count;
+}
+
+mc_sys_id_t mc_sys_get_input_count(const mc_system_t *sys)
+{
+    CHECK_SYSTEM(sys);
+    return sys->state->input_count;
+}
+
+mc_sys_id_t mc_sys_get_output_count(const mc_system_t *sys)
+{
+    CHECK_SYSTEM(sys);
+    return sys->state->output_count;
+}
+
+mc_sys_id_t mc_sys_get_alias_count(const mc_system_t *sys)
+{
+    CHECK_SYSTEM(sys);
+    return sys->state->alias_count;
 }
\ No newline at end of file
@@ -1,3 +1,5 @@
+#define MC_FILE_ID MC_FILE_ID_ANALOG_SYSTEM
+
 #include "mc/system/modules/analog_system.h"
 #include <string.h>
 
@@ -18,29 +20,31 @@ void analog_sys_init(void *ctx)
 {
     mc_analog_system_ctx_t *analog_ctx = (mc_analog_system_ctx_t *)ctx;
     mc_result_t current_value = mc_analog_get_value(analog_ctx->device);
-    analog_ctx->target_value = current_value.ok ? current_value.value : 0;
+    analog_ctx->target_value =
+        MC_RESULT_IS_OK(current_value) ? MC_RESULT_VALUE(current_value) : 0;
 }
 
-mc_status_t analog_sys_write_input(void *ctx, uint8_t x_id, int32_t val)
+mc_status_t analog_sys_write_input(void *ctx, mc_sys_id_t x_id, int32_t val)
 {
     mc_analog_system_ctx_t *analog_ctx = (mc_analog_system_ctx_t *)ctx;
     analog_ctx->target_value = val;
     return mc_analog_set_value(analog_ctx->device, val);
 }
 
-mc_result_t analog_sys_read_input(void *ctx, uint8_t x_id)
+mc_result_t analog_sys_read_input(void *ctx, mc_sys_id_t x_id)
 {
     mc_analog_system_ctx_t *analog_ctx = (mc_analog_system_ctx_t *)ctx;
     return MC_OK_VAL(analog_ctx->target_value);
 }
 
-mc_result_t analog_sys_read_output(void *ctx, uint8_t y_id)
+mc_result_t analog_sys_read_output(void *ctx, mc_sys_id_t y_id)
 {
     mc_analog_system_ctx_t *analog_ctx = (mc_analog_system_ctx_t *)ctx;
     return mc_analog_get_value(analog_ctx->device);
 }
 
-mc_status_t analog_sys_get_alias(void *ctx, uint8_t id, mc_sys_cmd_info_t *info)
+mc_status_t analog_sys_get_alias(void *ctx, mc_sys_id_t id,
+                                 mc_sys_cmd_info_t *info)
 {
     mc_analog_system_ctx_t *analog_ctx = (mc_analog_system_ctx_t *)ctx;
     switch (id)
@@ -62,32 +66,46 @@ mc_status_t analog_sys_get_alias(void *ctx, uint8_t id, mc_sys_cmd_info_t *info)
     }
 }
 
-uint8_t analog_sys_get_function_count(void *ctx)
+// Helper: read-only state of the device, remembered for counts_changed.
+static bool track_read_only(mc_analog_system_ctx_t *analog_ctx)
+{
+    analog_ctx->is_read_only = analog_ctx->device->config->is_read_only;
+    return analog_ctx->is_read_only;
+}
+
+mc_sys_id_t analog_sys_get_function_count(void *ctx)
 {
     return ANALOG_SYS_F_COUNT;
 }
 
-uint8_t analog_sys_get_input_count(void *ctx)
+mc_sys_id_t analog_sys_get_input_count(void *ctx)
 {
     mc_analog_system_ctx_t *analog_ctx = (mc_analog_system_ctx_t *)ctx;
-    return analog_ctx->device->config->is_read_only
+    return track_read_only(analog_ctx)
                ? ANALOG_SYS_READ_ONLY_X_COUNT
                : ANALOG_SYS_X_COUNT;
 }
 
-uint8_t analog_sys_get_output_count(void *ctx)
+mc_sys_id_t analog_sys_get_output_count(void *ctx)
 {
     return ANALOG_SYS_Y_COUNT;
 }
 
-uint8_t analog_sys_get_alias_count(void *ctx)
+mc_sys_id_t analog_sys_get_alias_count(void *ctx)
 {
     mc_analog_system_ctx_t *analog_ctx = (mc_analog_system_ctx_t *)ctx;
-    return analog_ctx->device->config->is_read_only
+    return track_read_only(analog_ctx)
                ? ANALOG_SYS_READ_ONLY_ALIAS_COUNT
                : ANALOG_SYS_ALIAS_COUNT;
 }
 
+// Member counts follow the device's read-only flag.
+bool analog_sys_counts_changed(void *ctx)
+{
+    mc_analog_system_ctx_t *analog_ctx = (mc_analog_system_ctx_t *)ctx;
+    return analog_ctx->is_read_only != analog_ctx->device->config->is_read_only;
+}
+
 const mc_system_driver_t mc_analog_sys_driver = {
     .init = analog_sys_init,
     .invoke = NULL,
@@ -98,4 +116,5 @@ const mc_system_driver_t mc_analog_sys_driver = {
     .get_function_count = analog_sys_get_function_count,
     .get_input_count = analog_sys_get_input_count,
     .get_output_count = analog_sys_get_output_count,
-    .get_alias_count = analog_sys_get_alias_count};
+    .get_alias_count = analog_sys_get_alias_count,
+    .counts_changed = analog_sys_counts_changed};
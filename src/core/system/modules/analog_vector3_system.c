@@ -1,3 +1,5 @@
+#define MC_FILE_ID MC_FILE_ID_ANALOG_VECTOR3_SYSTEM
+
 #include "mc/system/modules/analog_vector3_system.h"
 #include "mc/system/modules/analog_system.h"
 #include "mc/system/composite.h"
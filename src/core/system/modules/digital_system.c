@@ -1,3 +1,5 @@
+#define MC_FILE_ID MC_FILE_ID_DIGITAL_SYSTEM
+
 #include "mc/system/modules/digital_system.h"
 #include <string.h>
 
@@ -26,10 +28,11 @@ void digital_sys_init(void *ctx)
 {
     mc_digital_system_ctx_t *digital_ctx = (mc_digital_system_ctx_t *)ctx;
     mc_result_t current_state = mc_digital_get_state(digital_ctx->device);
-    digital_ctx->target_state = current_state.ok ? current_state.value : false;
+    digital_ctx->target_state =
+        MC_RESULT_IS_OK(current_state) ? MC_RESULT_VALUE(current_state) : false;
 }
 
-mc_status_t digital_sys_invoke(void *ctx, uint8_t func_id, int32_t *args,
+mc_status_t digital_sys_invoke(void *ctx, mc_sys_id_t func_id, int32_t *args,
                                uint8_t arg_count)
 {
     mc_digital_system_ctx_t *digital_ctx = (mc_digital_system_ctx_t *)ctx;
@@ -41,26 +44,27 @@ mc_status_t digital_sys_invoke(void *ctx, uint8_t func_id, int32_t *args,
     return mc_digital_toggle(digital_ctx->device);
 }
 
-mc_status_t digital_sys_write_input(void *ctx, uint8_t x_id, int32_t val)
+mc_status_t digital_sys_write_input(void *ctx, mc_sys_id_t x_id, int32_t val)
 {
     mc_digital_system_ctx_t *digital_ctx = (mc_digital_system_ctx_t *)ctx;
     digital_ctx->target_state = val;
     return mc_digital_set_state(digital_ctx->device, val);
 }
 
-mc_result_t digital_sys_read_input(void *ctx, uint8_t x_id)
+mc_result_t digital_sys_read_input(void *ctx, mc_sys_id_t x_id)
 {
     mc_digital_system_ctx_t *digital_ctx = (mc_digital_system_ctx_t *)ctx;
     return MC_OK_VAL(digital_ctx->target_state);
 }
 
-mc_result_t digital_sys_read_output(void *ctx, uint8_t y_id)
+mc_result_t digital_sys_read_output(void *ctx, mc_sys_id_t y_id)
 {
     mc_digital_system_ctx_t *digital_ctx = (mc_digital_system_ctx_t *)ctx;
     return mc_digital_get_state(digital_ctx->device);
 }
 
-mc_status_t digital_sys_get_alias(void *ctx, uint8_t id, mc_sys_cmd_info_t *info)
+mc_status_t digital_sys_get_alias(void *ctx, mc_sys_id_t id,
+                                  mc_sys_cmd_info_t *info)
 {
     mc_digital_system_ctx_t *digital_ctx = (mc_digital_system_ctx_t *)ctx;
     switch (id)
@@ -102,38 +106,52 @@ mc_status_t digital_sys_get_alias(void *ctx, uint8_t id, mc_sys_cmd_info_t *info
     }
 }
 
-uint8_t digital_sys_get_function_count(void *ctx)
+// Helper: read-only state of the device, remembered for counts_changed.
+static bool track_read_only(mc_digital_system_ctx_t *digital_ctx)
+{
+    digital_ctx->is_read_only = digital_ctx->device->config->is_read_only;
+    return digital_ctx->is_read_only;
+}
+
+mc_sys_id_t digital_sys_get_function_count(void *ctx)
 {
     mc_digital_system_ctx_t *digital_ctx = (mc_digital_system_ctx_t *)ctx;
-    return digital_ctx->device->config->is_read_only
+    return track_read_only(digital_ctx)
                ? DIGITAL_SYS_READ_ONLY_F_COUNT
                : DIGITAL_SYS_F_COUNT;
 }
 
-uint8_t digital_sys_get_input_count(void *ctx)
+mc_sys_id_t digital_sys_get_input_count(void *ctx)
 {
     mc_digital_system_ctx_t *digital_ctx = (mc_digital_system_ctx_t *)ctx;
-    return digital_ctx->device->config->is_read_only
+    return track_read_only(digital_ctx)
                ? DIGITAL_SYS_READ_ONLY_X_COUNT
                : DIGITAL_SYS_X_COUNT;
 }
 
-uint8_t digital_sys_get_output_count(void *ctx)
+mc_sys_id_t digital_sys_get_output_count(void *ctx)
 {
     mc_digital_system_ctx_t *digital_ctx = (mc_digital_system_ctx_t *)ctx;
-    return digital_ctx->device->config->is_read_only
+    return track_read_only(digital_ctx)
                ? DIGITAL_SYS_READ_ONLY_Y_COUNT
                : DIGITAL_SYS_Y_COUNT;
 }
 
-uint8_t digital_sys_get_alias_count(void *ctx)
+mc_sys_id_t digital_sys_get_alias_count(void *ctx)
 {
     mc_digital_system_ctx_t *digital_ctx = (mc_digital_system_ctx_t *)ctx;
-    return digital_ctx->device->config->is_read_only
+    return track_read_only(digital_ctx)
                ? DIGITAL_SYS_READ_ONLY_ALIAS_COUNT
                : DIGITAL_SYS_ALIAS_COUNT;
 }
 
+// Member counts follow the device's read-only flag.
+bool digital_sys_counts_changed(void *ctx)
+{
+    mc_digital_system_ctx_t *digital_ctx = (mc_digital_system_ctx_t *)ctx;
+    return digital_ctx->is_read_only != digital_ctx->device->config->is_read_only;
+}
+
 const mc_system_driver_t mc_digital_sys_driver = {
     .init = digital_sys_init,
     .invoke = digital_sys_invoke,
@@ -144,4 +162,5 @@ const mc_system_driver_t mc_digital_sys_driver = {
     .get_function_count = digital_sys_get_function_count,
     .get_input_count = digital_sys_get_input_count,
     .get_output_count = digital_sys_get_output_count,
-    .get_alias_count = digital_sys_get_alias_count};
+    .get_alias_count = digital_sys_get_alias_count,
+    .counts_changed = digital_sys_counts_changed};
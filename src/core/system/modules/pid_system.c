@@ -0,0 +1,218 @@
+#define MC_FILE_ID MC_FILE_ID_PID_SYSTEM
+
+#include "mc/system/modules/pid_system.h"
+#include "mc/utils.h"
+
+#define PID_SYS_X_COUNT 4
+#define PID_SYS_Y_COUNT 2
+#define PID_SYS_F_COUNT 1
+#define PID_SYS_ALIAS_COUNT 7
+#define PID_SYS_MS_PER_S 1000
+
+// Helper: clamps value into [min, max].
+static inline int64_t clamp(int64_t value, int64_t min, int64_t max)
+{
+    return value < min ? min : (value > max ? max : value);
+}
+
+// Helper: clears integral and derivative history.
+static void pid_reset(mc_pid_system_ctx_t *pid_ctx)
+{
+    pid_ctx->integral = 0;
+    pid_ctx->has_prev_value = false;
+}
+
+void pid_sys_init(void *ctx)
+{
+    mc_pid_system_ctx_t *pid_ctx = (mc_pid_system_ctx_t *)ctx;
+    const mc_pid_system_config_t *config = pid_ctx->config;
+    MC_ASSERT(config->output_min <= config->output_max);
+
+    mc_result_t current_value = mc_analog_get_value(pid_ctx->sensor);
+    pid_ctx->setpoint =
+        MC_RESULT_IS_OK(current_value) ? MC_RESULT_VALUE(current_value) : 0;
+    pid_ctx->kp = config->kp;
+    pid_ctx->ki = config->ki;
+    pid_ctx->kd = config->kd;
+    pid_ctx->output = 0;
+    pid_reset(pid_ctx);
+}
+
+mc_status_t pid_sys_update(void *ctx, uint32_t dt_ms)
+{
+    mc_pid_system_ctx_t *pid_ctx = (mc_pid_system_ctx_t *)ctx;
+    const mc_pid_system_config_t *config = pid_ctx->config;
+    MC_ASSIGN_OR_RETURN(value, mc_analog_get_value(pid_ctx->sensor));
+
+    int64_t error = (int64_t)pid_ctx->setpoint - value;
+    int64_t min = (int64_t)config->output_min * MC_PID_Q16_ONE;
+    int64_t max = (int64_t)config->output_max * MC_PID_Q16_ONE;
+
+    int64_t p = (int64_t)pid_ctx->kp * error;
+    int64_t d = 0;
+    if (pid_ctx->has_prev_value && dt_ms > 0)
+    {
+        int64_t change = (int64_t)value - pid_ctx->prev_value;
+        d = -(int64_t)pid_ctx->kd * change * PID_SYS_MS_PER_S / dt_ms;
+    }
+
+    // Skip integrating while saturated and the error pushes further out.
+    int64_t integral = clamp(
+        pid_ctx->integral +
+            (int64_t)pid_ctx->ki * error * dt_ms / PID_SYS_MS_PER_S,
+        min, max);
+    int64_t unclamped = p + integral + d;
+    if (!((unclamped > max && error > 0) || (unclamped < min && error < 0)))
+    {
+        pid_ctx->integral = integral;
+    }
+
+    int64_t output = clamp(p + pid_ctx->integral + d, min, max);
+    pid_ctx->output = (int32_t)(output / MC_PID_Q16_ONE);
+    pid_ctx->prev_value = value;
+    pid_ctx->has_prev_value = true;
+    return mc_analog_set_value(pid_ctx->actuator, pid_ctx->output);
+}
+
+mc_status_t pid_sys_invoke(void *ctx, mc_sys_id_t func_id, int32_t *args,
+                           uint8_t arg_count)
+{
+    mc_pid_system_ctx_t *pid_ctx = (mc_pid_system_ctx_t *)ctx;
+    pid_reset(pid_ctx);
+    return MC_OK;
+}
+
+mc_status_t pid_sys_write_input(void *ctx, mc_sys_id_t x_id, int32_t val)
+{
+    mc_pid_system_ctx_t *pid_ctx = (mc_pid_system_ctx_t *)ctx;
+    switch (x_id)
+    {
+    case 0:
+        pid_ctx->setpoint = val;
+        return MC_OK;
+    case 1:
+        pid_ctx->kp = val;
+        return MC_OK;
+    case 2:
+        pid_ctx->ki = val;
+        return MC_OK;
+    case 3:
+        pid_ctx->kd = val;
+        return MC_OK;
+    default:
+        return MC_ERROR_INVALID_ARGS;
+    }
+}
+
+mc_result_t pid_sys_read_input(void *ctx, mc_sys_id_t x_id)
+{
+    mc_pid_system_ctx_t *pid_ctx = (mc_pid_system_ctx_t *)ctx;
+    switch (x_id)
+    {
+    case 0:
+        return MC_OK_VAL(pid_ctx->setpoint);
+    case 1:
+        return MC_OK_VAL(pid_ctx->kp);
+    case 2:
+        return MC_OK_VAL(pid_ctx->ki);
+    case 3:
+        return MC_OK_VAL(pid_ctx->kd);
+    default:
+        return MC_ERR_VAL(MC_ERROR_INVALID_ARGS);
+    }
+}
+
+mc_result_t pid_sys_read_output(void *ctx, mc_sys_id_t y_id)
+{
+    mc_pid_system_ctx_t *pid_ctx = (mc_pid_system_ctx_t *)ctx;
+    switch (y_id)
+    {
+    case 0:
+        return mc_analog_get_value(pid_ctx->sensor);
+    case 1:
+        return MC_OK_VAL(pid_ctx->output);
+    default:
+        return MC_ERR_VAL(MC_ERROR_INVALID_ARGS);
+    }
+}
+
+mc_status_t pid_sys_get_alias(void *ctx, mc_sys_id_t id,
+                              mc_sys_cmd_info_t *info)
+{
+    mc_pid_system_ctx_t *pid_ctx = (mc_pid_system_ctx_t *)ctx;
+    const mc_pid_system_config_t *config = pid_ctx->config;
+    info->has_preset = false;
+    switch (id)
+    {
+    case 0:
+        info->alias = config->value_name;
+        info->type = MC_CMD_TYPE_OUTPUT;
+        info->id = 0;
+        return MC_OK;
+    case 1:
+        info->alias = config->output_name;
+        info->type = MC_CMD_TYPE_OUTPUT;
+        info->id = 1;
+        return MC_OK;
+    case 2:
+        info->alias = config->setpoint_name;
+        info->type = MC_CMD_TYPE_INPUT;
+        info->id = 0;
+        return MC_OK;
+    case 3:
+        info->alias = config->kp_name;
+        info->type = MC_CMD_TYPE_INPUT;
+        info->id = 1;
+        return MC_OK;
+    case 4:
+        info->alias = config->ki_name;
+        info->type = MC_CMD_TYPE_INPUT;
+        info->id = 2;
+        return MC_OK;
+    case 5:
+        info->alias = config->kd_name;
+        info->type = MC_CMD_TYPE_INPUT;
+        info->id = 3;
+        return MC_OK;
+    case 6:
+        info->alias = config->reset_name;
+        info->type = MC_CMD_TYPE_FUNC;
+        info->id = 0;
+        return MC_OK;
+    default:
+        return MC_ERROR_INVALID_ARGS;
+    }
+}
+
+mc_sys_id_t pid_sys_get_function_count(void *ctx)
+{
+    return PID_SYS_F_COUNT;
+}
+
+mc_sys_id_t pid_sys_get_input_count(void *ctx)
+{
+    return PID_SYS_X_COUNT;
+}
+
+mc_sys_id_t pid_sys_get_output_count(void *ctx)
+{
+    return PID_SYS_Y_COUNT;
+}
+
+mc_sys_id_t pid_sys_get_alias_count(void *ctx)
+{
+    return PID_SYS_ALIAS_COUNT;
+}
+
+const mc_system_driver_t mc_pid_sys_driver = {
+    .init = pid_sys_init,
+    .invoke = pid_sys_invoke,
+    .write_input = pid_sys_write_input,
+    .read_input = pid_sys_read_input,
+    .read_output = pid_sys_read_output,
+    .get_alias = pid_sys_get_alias,
+    .get_function_count = pid_sys_get_function_count,
+    .get_input_count = pid_sys_get_input_count,
+    .get_output_count = pid_sys_get_output_count,
+    .get_alias_count = pid_sys_get_alias_count,
+    .update = pid_sys_update};
@@ -0,0 +1,83 @@
+#define MC_FILE_ID MC_FILE_ID_SYS_REGISTRY
+
+#include "mc/system/registry.h"
+#include "mc/utils.h"
+
+#define CHECK_REGISTRY(reg)                                      \
+    do                                                           \
+    {                                                            \
+        MC_ASSERT(reg != NULL);                                  \
+        MC_ASSERT(reg->state->is_initialized == MC_INITIALIZED); \
+    } while (0)
+
+void mc_sys_registry_init(const mc_sys_registry_t *reg)
+{
+    MC_ASSERT(reg != NULL);
+    MC_ASSERT(reg->entries != NULL || reg->count == 0);
+    MC_ASSERT(reg->names != NULL || reg->count == 0);
+    MC_ASSERT(reg->state != NULL);
+
+    // Insertion sort by hash, runs once on a small table.
+    for (uint8_t i = 0; i < reg->count; i++)
+    {
+        // IDs are generated from the list order.
+        MC_ASSERT(reg->entries[i].id == i);
+        const char *name = reg->entries[i].name;
+        MC_ASSERT(name != NULL);
+
+        mc_sys_registry_name_t entry = {
+            .hash = mc_hash_bytes(name, strlen(name)),
+            .len = (uint8_t)strlen(name),
+            .index = i};
+        uint8_t j = i;
+        while (j > 0 && reg->names[j - 1].hash > entry.hash)
+        {
+            reg->names[j] = reg->names[j - 1];
+            j--;
+        }
+        reg->names[j] = entry;
+    }
+    reg->state->is_initialized = MC_INITIALIZED;
+}
+
+const mc_system_entry_t *mc_sys_registry_get(const mc_sys_registry_t *reg,
+                                             mc_sys_id_t id)
+{
+    CHECK_REGISTRY(reg);
+    return id < reg->count ? &reg->entries[id] : NULL;
+}
+
+const mc_system_entry_t *mc_sys_registry_find(const mc_sys_registry_t *reg,
+                                              const char *name, size_t len)
+{
+    CHECK_REGISTRY(reg);
+    MC_ASSERT(name != NULL);
+
+    // Find the first index with this hash.
+    uint32_t hash = mc_hash_bytes(name, len);
+    uint8_t low = 0;
+    uint8_t high = reg->count;
+    while (low < high)
+    {
+        uint8_t mid = low + (high - low) / 2;
+        if (reg->names[mid].hash < hash)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    // Confirm with a string compare, hashes may collide.
+    for (uint8_t i = low; i < reg->count && reg->names[i].hash == hash; i++)
+    {
+        const mc_system_entry_t *entry = &reg->entries[reg->names[i].index];
+        if (reg->names[i].len == len && strncmp(entry->name, name, len) == 0)
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
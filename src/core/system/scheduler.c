@@ -0,0 +1,83 @@
+#define MC_FILE_ID MC_FILE_ID_SYS_SCHEDULER
+
+#include "mc/system/scheduler.h"
+#include "mc/time.h"
+#include "mc/utils.h"
+
+#define CHECK_TASK(task)                                          \
+    do                                                            \
+    {                                                             \
+        MC_ASSERT(task != NULL);                                  \
+        MC_ASSERT(task->state->is_initialized == MC_INITIALIZED); \
+    } while (0)
+
+// Started tasks.
+static mc_list_t tasks_ = {0};
+
+void mc_sys_task_start(const mc_sys_task_t *task)
+{
+    MC_ASSERT(task != NULL);
+    MC_ASSERT(task->system != NULL);
+    MC_ASSERT(task->state != NULL);
+    MC_ASSERT(task->period_ms > 0);
+    // Already started
+    MC_ASSERT(task->state->is_initialized != MC_INITIALIZED);
+
+    mc_sys_task_state_t *state = task->state;
+    uint32_t now = mc_time_get_ms();
+    state->task = task;
+    state->last_ms = now;
+    state->next_ms = now + task->period_ms;
+    state->overrun_count = 0;
+    state->is_initialized = MC_INITIALIZED;
+    mc_list_append(&tasks_, &state->node);
+}
+
+void mc_sys_task_stop(const mc_sys_task_t *task)
+{
+    CHECK_TASK(task);
+    mc_list_remove(&tasks_, &task->state->node);
+    task->state->is_initialized = 0;
+}
+
+uint8_t mc_sys_tasks_run(void)
+{
+    uint8_t run = 0;
+    uint32_t now = mc_time_get_ms();
+    mc_node_t *pos;
+    mc_node_t *next;
+    // Safe iteration, updates may stop tasks.
+    MC_LIST_FOR_EACH_SAFE(pos, next, &tasks_)
+    {
+        mc_sys_task_state_t *state =
+            MC_LIST_ENTRY(pos, mc_sys_task_state_t, node);
+        const mc_sys_task_t *task = state->task;
+
+        // Wrap-safe "now < next_ms"
+        if ((int32_t)(now - state->next_ms) < 0)
+        {
+            continue;
+        }
+
+        uint32_t dt_ms = now - state->last_ms;
+        state->last_ms = now;
+        state->next_ms += task->period_ms;
+        if ((int32_t)(now - state->next_ms) >= 0)
+        {
+            // Fell behind by a full period, skip to the next deadline.
+            uint32_t missed = (now - state->next_ms) / task->period_ms + 1;
+            state->overrun_count += missed;
+            state->next_ms += missed * task->period_ms;
+        }
+
+        mc_sys_update(task->system, dt_ms);
+        run++;
+    }
+    return run;
+}
+
+uint32_t mc_sys_task_get_overrun_count(const mc_sys_task_t *task)
+{
+    CHECK_TASK(task);
+    return task->state->overrun_count;
+}
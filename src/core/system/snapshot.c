@@ -0,0 +1,165 @@
+#define MC_FILE_ID MC_FILE_ID_SYS_SNAPSHOT
+
+#include "mc/system/snapshot.h"
+
+#define CHECK_SNAPSHOT(snap)                                      \
+    do                                                            \
+    {                                                             \
+        MC_ASSERT(snap != NULL);                                  \
+        MC_ASSERT(snap->state->is_initialized == MC_INITIALIZED); \
+    } while (0)
+
+// Helper: index of the buffer readers use.
+static inline uint8_t front_buffer(const mc_snapshot_t *snap)
+{
+    return snap->state->sequence & 1;
+}
+
+// Helper: layout of a system in the given buffer.
+static inline const mc_snapshot_layout_t *get_layout(
+    const mc_snapshot_t *snap, uint8_t buffer, uint8_t sys_index)
+{
+    MC_ASSERT(sys_index < snap->system_count);
+    return &snap->layouts[buffer * snap->system_count + sys_index];
+}
+
+// Helper: reads a captured member from the front buffer.
+static mc_result_t read_member(const mc_snapshot_t *snap, uint8_t sys_index,
+                               bool is_output, mc_sys_id_t id)
+{
+    uint8_t buffer = front_buffer(snap);
+    const mc_snapshot_layout_t *layout = get_layout(snap, buffer, sys_index);
+    mc_sys_id_t count = is_output ? layout->y_count : layout->x_count;
+    if (id >= count)
+    {
+        return MC_ERR_VAL(MC_ERROR_INVALID_ARGS);
+    }
+
+    uint16_t first = is_output ? layout->y_first : layout->x_first;
+    uint32_t index = (uint32_t)buffer * snap->capacity + first + id;
+    if (snap->errors[index] != MC_OK)
+    {
+        return MC_ERR_VAL(snap->errors[index]);
+    }
+    return MC_OK_VAL(snap->values[index]);
+}
+
+void mc_snapshot_init(const mc_snapshot_t *snap)
+{
+    MC_ASSERT(snap != NULL);
+    MC_ASSERT(snap->systems != NULL);
+    MC_ASSERT(snap->layouts != NULL);
+    MC_ASSERT(snap->values != NULL);
+    MC_ASSERT(snap->errors != NULL);
+    MC_ASSERT(snap->state != NULL);
+
+    memset(snap->layouts, 0,
+           2 * snap->system_count * sizeof(mc_snapshot_layout_t));
+    snap->state->sequence = 0;
+    snap->state->is_initialized = MC_INITIALIZED;
+}
+
+mc_status_t mc_snapshot_capture(const mc_snapshot_t *snap)
+{
+    CHECK_SNAPSHOT(snap);
+
+    uint8_t back = front_buffer(snap) ^ 1;
+    int32_t *values = snap->values + back * snap->capacity;
+    mc_status_t *errors = snap->errors + back * snap->capacity;
+    mc_snapshot_layout_t *layouts =
+        snap->layouts + back * snap->system_count;
+
+    mc_status_t ret = MC_OK;
+    uint16_t used = 0;
+    for (uint8_t i = 0; i < snap->system_count; i++)
+    {
+        const mc_system_t *sys = snap->systems[i];
+        mc_snapshot_layout_t *layout = &layouts[i];
+        mc_sys_id_t x_count = mc_sys_get_input_count(sys);
+        mc_sys_id_t y_count = mc_sys_get_output_count(sys);
+        if ((uint32_t)used + x_count + y_count > snap->capacity)
+        {
+            // Leave the system out rather than capture it partially.
+            x_count = 0;
+            y_count = 0;
+            ret = MC_ERROR_NO_RESOURCE;
+        }
+
+        layout->x_first = used;
+        layout->x_count = x_count;
+        for (mc_sys_id_t x = 0; x < x_count; x++)
+        {
+            mc_result_t res = mc_sys_read_input(sys, x);
+            values[used + x] = MC_RESULT_IS_OK(res) ? MC_RESULT_VALUE(res) : 0;
+            errors[used + x] = MC_RESULT_IS_OK(res) ? MC_OK
+                                                    : MC_RESULT_ERROR(res);
+        }
+        used += x_count;
+
+        layout->y_first = used;
+        layout->y_count = y_count;
+        if (y_count > 0)
+        {
+            mc_sys_read_outputs(sys, 0, y_count, values + used, errors + used);
+            for (mc_sys_id_t y = 0; y < y_count; y++)
+            {
+                if (errors[used + y] != MC_OK)
+                {
+                    values[used + y] = 0;
+                }
+            }
+        }
+        used += y_count;
+    }
+
+    // Publish only after the whole buffer is written.
+    MC_COMPILER_BARRIER();
+    snap->state->sequence++;
+    return ret;
+}
+
+uint32_t mc_snapshot_get_sequence(const mc_snapshot_t *snap)
+{
+    CHECK_SNAPSHOT(snap);
+    return snap->state->sequence;
+}
+
+mc_result_t mc_snapshot_read_input(const mc_snapshot_t *snap,
+                                   uint8_t sys_index, mc_sys_id_t x_id)
+{
+    CHECK_SNAPSHOT(snap);
+    return read_member(snap, sys_index, false, x_id);
+}
+
+mc_result_t mc_snapshot_read_output(const mc_snapshot_t *snap,
+                                    uint8_t sys_index, mc_sys_id_t y_id)
+{
+    CHECK_SNAPSHOT(snap);
+    return read_member(snap, sys_index, true, y_id);
+}
+
+const int32_t *mc_snapshot_get_inputs(const mc_snapshot_t *snap,
+                                      uint8_t sys_index,
+                                      mc_sys_id_t *out_count)
+{
+    CHECK_SNAPSHOT(snap);
+    MC_ASSERT(out_count != NULL);
+
+    uint8_t buffer = front_buffer(snap);
+    const mc_snapshot_layout_t *layout = get_layout(snap, buffer, sys_index);
+    *out_count = layout->x_count;
+    return snap->values + buffer * snap->capacity + layout->x_first;
+}
+
+const int32_t *mc_snapshot_get_outputs(const mc_snapshot_t *snap,
+                                       uint8_t sys_index,
+                                       mc_sys_id_t *out_count)
+{
+    CHECK_SNAPSHOT(snap);
+    MC_ASSERT(out_count != NULL);
+
+    uint8_t buffer = front_buffer(snap);
+    const mc_snapshot_layout_t *layout = get_layout(snap, buffer, sys_index);
+    *out_count = layout->y_count;
+    return snap->values + buffer * snap->capacity + layout->y_first;
+}
@@ -0,0 +1,113 @@
+#define MC_FILE_ID MC_FILE_ID_SYS_SUBSCRIPTION
+
+#include "mc/system/subscription.h"
+#include "mc/utils.h"
+
+#define CHECK_SUBSCRIPTION(sub)                                  \
+    do                                                           \
+    {                                                            \
+        MC_ASSERT(sub != NULL);                                  \
+        MC_ASSERT(sub->state->is_initialized == MC_INITIALIZED); \
+    } while (0)
+
+// Helper: fires subscription if value moved past the deadband. Returns true
+// if fired.
+static bool evaluate(mc_sys_subscription_state_t *state, int32_t value)
+{
+    const mc_sys_subscription_t *sub = state->sub;
+    int64_t diff = (int64_t)value - state->last_value;
+    if (state->has_value && diff <= (int64_t)sub->deadband &&
+        -diff <= (int64_t)sub->deadband)
+    {
+        return false;
+    }
+
+    mc_sys_output_change_t change = {
+        .system = sub->system,
+        .y_id = sub->y_id,
+        .value = value,
+        .previous = state->has_value ? state->last_value : value};
+    state->last_value = value;
+    state->has_value = true;
+    mc_event_trigger(&state->event, &change);
+    return true;
+}
+
+void mc_sys_subscribe(const mc_sys_subscription_t *sub)
+{
+    MC_ASSERT(sub != NULL);
+    MC_ASSERT(sub->system != NULL);
+    MC_ASSERT(sub->state != NULL);
+    // Already subscribed
+    MC_ASSERT(sub->state->is_initialized != MC_INITIALIZED);
+
+    mc_sys_subscription_state_t *state = sub->state;
+    mc_event_init(&state->event);
+    state->sub = sub;
+    state->last_value = 0;
+    state->has_value = false;
+    state->is_initialized = MC_INITIALIZED;
+    mc_list_append(&sub->system->state->subscriptions, &state->node);
+}
+
+void mc_sys_unsubscribe(const mc_sys_subscription_t *sub)
+{
+    CHECK_SUBSCRIPTION(sub);
+    mc_list_remove(&sub->system->state->subscriptions, &sub->state->node);
+    sub->state->is_initialized = 0;
+}
+
+void mc_sys_subscription_register(const mc_sys_subscription_t *sub,
+                                  mc_callback_t *cb)
+{
+    CHECK_SUBSCRIPTION(sub);
+    mc_event_register(&sub->state->event, cb);
+}
+
+void mc_sys_subscription_unregister(const mc_sys_subscription_t *sub,
+                                    mc_callback_t *cb)
+{
+    CHECK_SUBSCRIPTION(sub);
+    mc_event_unregister(&sub->state->event, cb);
+}
+
+uint8_t mc_sys_poll_subscriptions(const mc_system_t *sys)
+{
+    MC_ASSERT(sys != NULL);
+
+    uint8_t fired = 0;
+    mc_node_t *pos;
+    mc_node_t *next;
+    // Safe iteration, listeners may unsubscribe.
+    MC_LIST_FOR_EACH_SAFE(pos, next, &sys->state->subscriptions)
+    {
+        mc_sys_subscription_state_t *state =
+            MC_LIST_ENTRY(pos, mc_sys_subscription_state_t, node);
+        mc_result_t res = mc_sys_read_output(sys, state->sub->y_id);
+        if (MC_RESULT_IS_OK(res) && evaluate(state, MC_RESULT_VALUE(res)))
+        {
+            fired++;
+        }
+    }
+    return fired;
+}
+
+uint8_t mc_sys_notify_output(const mc_system_t *sys, mc_sys_id_t y_id,
+                             int32_t value)
+{
+    MC_ASSERT(sys != NULL);
+
+    uint8_t fired = 0;
+    mc_node_t *pos;
+    mc_node_t *next;
+    MC_LIST_FOR_EACH_SAFE(pos, next, &sys->state->subscriptions)
+    {
+        mc_sys_subscription_state_t *state =
+            MC_LIST_ENTRY(pos, mc_sys_subscription_state_t, node);
+        if (state->sub->y_id == y_id && evaluate(state, value))
+        {
+            fired++;
+        }
+    }
+    return fired;
+}
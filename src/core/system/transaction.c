@@ -0,0 +1,114 @@
+#define MC_FILE_ID MC_FILE_ID_SYS_TRANSACTION
+
+#include "mc/system/transaction.h"
+#include "mc/utils.h"
+
+#define CHECK_TXN(txn)                                           \
+    do                                                           \
+    {                                                            \
+        MC_ASSERT(txn != NULL);                                  \
+        MC_ASSERT(txn->state->is_initialized == MC_INITIALIZED); \
+    } while (0)
+
+void mc_sys_txn_begin(const mc_sys_transaction_t *txn)
+{
+    MC_ASSERT(txn != NULL);
+    MC_ASSERT(txn->state != NULL);
+    MC_ASSERT(txn->systems != NULL);
+    MC_ASSERT(txn->x_ids != NULL);
+    MC_ASSERT(txn->values != NULL);
+
+    txn->state->count = 0;
+    txn->state->is_initialized = MC_INITIALIZED;
+}
+
+mc_status_t mc_sys_txn_write(const mc_sys_transaction_t *txn,
+                             const mc_system_t *sys, mc_sys_id_t x_id,
+                             int32_t val)
+{
+    CHECK_TXN(txn);
+    MC_ASSERT(sys != NULL);
+
+    if (!(mc_sys_get_capabilities(sys) & MC_SYS_CAP_WRITE_INPUT))
+    {
+        return MC_ERROR_NOT_SUPPORTED;
+    }
+    if (x_id >= mc_sys_get_input_count(sys))
+    {
+        return MC_ERROR_INVALID_ARGS;
+    }
+
+    // Find the end of this system's group, replacing a staged value.
+    uint8_t count = txn->state->count;
+    uint8_t pos = count;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (txn->systems[i] != sys)
+        {
+            continue;
+        }
+        if (txn->x_ids[i] == x_id)
+        {
+            txn->values[i] = val;
+            return MC_OK;
+        }
+        pos = i + 1;
+    }
+
+    if (count >= txn->capacity)
+    {
+        return MC_ERROR_NO_RESOURCE;
+    }
+
+    // Shift later groups up to keep this one contiguous.
+    for (uint8_t i = count; i > pos; i--)
+    {
+        txn->systems[i] = txn->systems[i - 1];
+        txn->x_ids[i] = txn->x_ids[i - 1];
+        txn->values[i] = txn->values[i - 1];
+    }
+    txn->systems[pos] = sys;
+    txn->x_ids[pos] = x_id;
+    txn->values[pos] = val;
+    txn->state->count = count + 1;
+    return MC_OK;
+}
+
+uint8_t mc_sys_txn_get_count(const mc_sys_transaction_t *txn)
+{
+    CHECK_TXN(txn);
+    return txn->state->count;
+}
+
+mc_status_t mc_sys_txn_commit(const mc_sys_transaction_t *txn)
+{
+    CHECK_TXN(txn);
+
+    mc_status_t ret = MC_OK;
+    uint8_t count = txn->state->count;
+    uint8_t start = 0;
+    while (start < count)
+    {
+        const mc_system_t *sys = txn->systems[start];
+        uint8_t end = start + 1;
+        while (end < count && txn->systems[end] == sys)
+        {
+            end++;
+        }
+
+        mc_status_t err =
+            mc_sys_commit_inputs(sys, end - start, txn->x_ids + start,
+                                 txn->values + start, NULL);
+        ret = ret != MC_OK ? ret : err;
+        start = end;
+    }
+
+    txn->state->count = 0;
+    return ret;
+}
+
+void mc_sys_txn_abort(const mc_sys_transaction_t *txn)
+{
+    CHECK_TXN(txn);
+    txn->state->count = 0;
+}
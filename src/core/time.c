@@ -1,3 +1,5 @@
+#define MC_FILE_ID MC_FILE_ID_TIME
+
 #include "mc/time.h"
 #include "mc/utils.h"
 
@@ -31,6 +33,19 @@ uint32_t mc_time_get_ms(void)
                : 0;
 }
 
+uint32_t mc_time_get_us(void)
+{
+    if (sys_time_initialized != MC_INITIALIZED)
+    {
+        return 0;
+    }
+    if (sys_time_driver->get_us)
+    {
+        return sys_time_driver->get_us(sys_time_ctx);
+    }
+    return sys_time_driver->get_ms(sys_time_ctx) * 1000;
+}
+
 void mc_time_delay(uint32_t ms)
 {
     if (sys_time_initialized == MC_INITIALIZED)
@@ -1,3 +1,5 @@
+#define MC_FILE_ID MC_FILE_ID_UTILS
+
 #include "mc/utils.h"
 #include "mc/debug.h"
 
@@ -31,4 +33,47 @@ void mc_assert_handler(const char *expr, const char *file, int line)
     {
         __asm("nop");
     }
+}
+
+uint32_t mc_hash_bytes(const void *data, size_t len)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+uint16_t mc_crc16_update(uint16_t crc, const void *data, size_t len)
+{
+    // Nibble table for polynomial 0x1021, 32 bytes instead of 512.
+    static const uint16_t table[16] = {
+        0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+        0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF};
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (size_t i = 0; i < len; i++)
+    {
+        crc = (uint16_t)((crc << 4) ^ table[(crc >> 12) ^ (bytes[i] >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ table[(crc >> 12) ^ (bytes[i] & 0x0F)]);
+    }
+    return crc;
+}
+
+void mc_assert_handler_compact(uint16_t file_id, int line)
+{
+    // Only the file ID is known, report it as "#<id>". Written by hand so
+    // compact builds do not need printf.
+    char file[7];
+    char *pos = &file[sizeof(file) - 1];
+    *pos = '\0';
+    do
+    {
+        *--pos = (char)('0' + file_id % 10);
+        file_id /= 10;
+    } while (file_id > 0);
+    *--pos = '#';
+    mc_assert_handler("?", pos, line);
 }
\ No newline at end of file
@@ -46,8 +46,8 @@ namespace
     {
         dev_ctx.value = -24445;
         mc_result_t res = mc_analog_get_value(&dev);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(-24445, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(-24445, MC_RESULT_VALUE(res));
     }
 
     TEST_F(AnalogTest, ReadOnlyGetValueSucceeds)
@@ -55,8 +55,8 @@ namespace
         mc_analog_set_read_only(&dev, true);
         dev_ctx.value = 849922;
         mc_result_t res = mc_analog_get_value(&dev);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(849922, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(849922, MC_RESULT_VALUE(res));
     }
 
     TEST_F(AnalogTest, ReadOnlySetValueFails)
@@ -76,8 +76,8 @@ namespace
 
         mc_result_t res;
         res = mc_analog_get_value(&dev);
-        EXPECT_FALSE(res.ok);
-        EXPECT_EQ(error, res.error);
+        EXPECT_FALSE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(error, MC_RESULT_ERROR(res));
     }
 
     TEST_F(AnalogTest, UnimplementedMethodsReturnNotSupported)
@@ -98,8 +98,8 @@ namespace
         EXPECT_EQ(MC_ERROR_NOT_SUPPORTED, ret);
 
         mc_result_t res = mc_analog_get_value(&null_dev);
-        EXPECT_FALSE(res.ok);
-        EXPECT_EQ(MC_ERROR_NOT_SUPPORTED, res.error);
+        EXPECT_FALSE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(MC_ERROR_NOT_SUPPORTED, MC_RESULT_ERROR(res));
     }
 
     TEST_F(AnalogTest, AssertDeathIfNullPointer)
@@ -50,13 +50,13 @@ namespace
     {
         dev_ctx.state = true;
         mc_result_t res = mc_digital_get_state(&dev);
-        EXPECT_TRUE(res.ok);
-        EXPECT_TRUE(res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_TRUE(MC_RESULT_VALUE(res));
 
         dev_ctx.state = false;
         res = mc_digital_get_state(&dev);
-        EXPECT_TRUE(res.ok);
-        EXPECT_FALSE(res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_FALSE(MC_RESULT_VALUE(res));
     }
 
     TEST_F(DigitalTest, ToggleSucceeds)
@@ -75,13 +75,13 @@ namespace
         mc_digital_set_read_only(&dev, true);
         dev_ctx.state = true;
         mc_result_t res = mc_digital_get_state(&dev);
-        EXPECT_TRUE(res.ok);
-        EXPECT_TRUE(res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_TRUE(MC_RESULT_VALUE(res));
 
         dev_ctx.state = false;
         res = mc_digital_get_state(&dev);
-        EXPECT_TRUE(res.ok);
-        EXPECT_FALSE(res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_FALSE(MC_RESULT_VALUE(res));
     }
 
     TEST_F(DigitalTest, ReadOnlySetStateFails)
@@ -108,8 +108,8 @@ namespace
 
         mc_result_t res;
         res = mc_digital_get_state(&dev);
-        EXPECT_FALSE(res.ok);
-        EXPECT_EQ(error, res.error);
+        EXPECT_FALSE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(error, MC_RESULT_ERROR(res));
 
         ret = mc_digital_toggle(&dev);
         EXPECT_EQ(error, ret);
@@ -133,8 +133,8 @@ namespace
         EXPECT_EQ(MC_ERROR_NOT_SUPPORTED, ret);
 
         mc_result_t res = mc_digital_get_state(&null_dev);
-        EXPECT_FALSE(res.ok);
-        EXPECT_EQ(MC_ERROR_NOT_SUPPORTED, res.error);
+        EXPECT_FALSE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(MC_ERROR_NOT_SUPPORTED, MC_RESULT_ERROR(res));
 
         ret = mc_digital_toggle(&null_dev);
         EXPECT_EQ(MC_ERROR_NOT_SUPPORTED, ret);
@@ -2,4 +2,65 @@
 
 MC_DEFINE_COMPOSITE_DRIVER(fake_composite_sys_driver, fake_composite_ctx_t,
                            MC_NODE(sys1, &fake_sys_driver),
-                           MC_NODE(sys2, &fake_sys_driver));
\ No newline at end of file
+                           MC_NODE(sys2, &fake_sys_driver));
+
+MC_DEFINE_COMPOSITE_DRIVER_WITH_INSTANCES(fake_single_composite_sys_driver,
+                                          fake_composite_ctx_t, 1,
+                                          MC_NODE(sys1, &fake_sys_driver),
+                                          MC_NODE(sys2, &fake_sys_driver));
+
+MC_DEFINE_COMPOSITE_DRIVER(fake_nested_composite_sys_driver,
+                           fake_nested_composite_ctx_t,
+                           MC_COMPOSITE_NODE(pair, fake_composite_sys_driver),
+                           MC_NODE(single, &fake_sys_driver));
+
+MC_DEFINE_COMPOSITE_DRIVER(fake_deep_composite_sys_driver,
+                           fake_deep_composite_ctx_t,
+                           MC_NODE(first, &fake_sys_driver),
+                           MC_COMPOSITE_NODE(nested,
+                                             fake_nested_composite_sys_driver));
+
+#define FAKE_WIDE_NODE(i) MC_NODE(sys[i], &fake_sys_driver)
+
+MC_DEFINE_COMPOSITE_DRIVER(fake_wide_composite_sys_driver,
+                           fake_wide_composite_ctx_t,
+                           FAKE_WIDE_NODE(0), FAKE_WIDE_NODE(1),
+                           FAKE_WIDE_NODE(2), FAKE_WIDE_NODE(3),
+                           FAKE_WIDE_NODE(4), FAKE_WIDE_NODE(5),
+                           FAKE_WIDE_NODE(6), FAKE_WIDE_NODE(7),
+                           FAKE_WIDE_NODE(8), FAKE_WIDE_NODE(9),
+                           FAKE_WIDE_NODE(10), FAKE_WIDE_NODE(11));
+
+static mc_status_t fake_sized_sys_write_input(void *ctx, mc_sys_id_t x_id,
+                                              int32_t val)
+{
+    fake_sized_sys_ctx_t *data = (fake_sized_sys_ctx_t *)ctx;
+    data->last_x_id = x_id;
+    data->last_val = val;
+    return MC_OK;
+}
+
+static mc_sys_id_t fake_sized_sys_get_input_count(void *ctx)
+{
+    fake_sized_sys_ctx_t *data = (fake_sized_sys_ctx_t *)ctx;
+    data->count_calls++;
+    return data->input_count;
+}
+
+static mc_status_t fake_sized_sys_update(void *ctx, uint32_t dt_ms)
+{
+    (void)dt_ms;
+    fake_sized_sys_ctx_t *data = (fake_sized_sys_ctx_t *)ctx;
+    data->update_calls++;
+    return MC_OK;
+}
+
+const mc_system_driver_t fake_sized_sys_driver = {
+    .write_input = fake_sized_sys_write_input,
+    .get_input_count = fake_sized_sys_get_input_count,
+    .update = fake_sized_sys_update};
+
+MC_DEFINE_COMPOSITE_DRIVER(fake_sized_composite_sys_driver,
+                           fake_sized_composite_ctx_t,
+                           MC_NODE(sys, &fake_sys_driver),
+                           MC_NODE(sized, &fake_sized_sys_driver));
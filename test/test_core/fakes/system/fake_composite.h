@@ -6,8 +6,11 @@ extern "C"
 #endif
 
 #include "mc/system/composite.h"
+#include "mc/system/modules/analog_system.h"
 #include "fakes/system/fake_system.h"
 
+#define FAKE_WIDE_COMPOSITE_COUNT 12
+
     // Composite system context.
     typedef struct
     {
@@ -16,7 +19,73 @@ extern "C"
     } fake_composite_ctx_t;
 
     // Composite system combining two test_systems
-    extern const mc_system_driver_t fake_composite_sys_driver;
+    MC_DECLARE_COMPOSITE_DRIVER(fake_composite_sys_driver);
+
+    // Same as fake_composite_sys_driver, with a table for one instance only.
+    extern const mc_system_driver_t fake_single_composite_sys_driver;
+
+    // Mixed composite context. The analog child loses its input when the
+    // device is read only.
+    typedef struct
+    {
+        mc_analog_system_ctx_t analog;
+        fake_sys_ctx_t sys;
+    } fake_mixed_composite_ctx_t;
+
+    // Composite system of an analog system and a test_system
+    extern const mc_system_driver_t fake_mixed_composite_sys_driver;
+
+    // Composite nesting fake_composite_sys_driver next to a test_system.
+    typedef struct
+    {
+        fake_composite_ctx_t pair;
+        fake_sys_ctx_t single;
+    } fake_nested_composite_ctx_t;
+
+    MC_DECLARE_COMPOSITE_DRIVER(fake_nested_composite_sys_driver);
+
+    // Two levels of nesting, with a test_system first.
+    typedef struct
+    {
+        fake_sys_ctx_t first;
+        fake_nested_composite_ctx_t nested;
+    } fake_deep_composite_ctx_t;
+
+    extern const mc_system_driver_t fake_deep_composite_sys_driver;
+
+    // More children than the old 10 argument limit.
+    typedef struct
+    {
+        fake_sys_ctx_t sys[FAKE_WIDE_COMPOSITE_COUNT];
+    } fake_wide_composite_ctx_t;
+
+    extern const mc_system_driver_t fake_wide_composite_sys_driver;
+
+    // System with only inputs, as many as input_count. Writes, count queries
+    // and updates are recorded.
+    typedef struct
+    {
+        mc_sys_id_t input_count;
+        mc_sys_id_t last_x_id;
+        int32_t last_val;
+        uint32_t count_calls;
+        uint32_t update_calls;
+    } fake_sized_sys_ctx_t;
+
+    extern const mc_system_driver_t fake_sized_sys_driver;
+
+    // A test_system followed by a sized system, to reach the ID limit.
+    typedef struct
+    {
+        fake_sys_ctx_t sys;
+        fake_sized_sys_ctx_t sized;
+    } fake_sized_composite_ctx_t;
+
+    extern const mc_system_driver_t fake_sized_composite_sys_driver;
+
+    // Same children as fake_composite_sys_driver, with static dispatch.
+    // Uses fake_composite_ctx_t.
+    extern const mc_system_driver_t fake_static_composite_sys_driver;
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,6 @@
+#include "fakes/system/fake_composite.h"
+
+MC_DEFINE_COMPOSITE_DRIVER(fake_mixed_composite_sys_driver,
+                           fake_mixed_composite_ctx_t,
+                           MC_NODE(analog, &mc_analog_sys_driver),
+                           MC_NODE(sys, &fake_sys_driver));
\ No newline at end of file
@@ -0,0 +1,11 @@
+#include "mc/system/static_composite.h"
+#include "fakes/system/fake_composite.h"
+
+#define FAKE_STATIC_NODE(field)                               \
+    MC_STATIC_NODE(field, &fake_sys_driver, FAKE_SYS_F_COUNT, \
+                   FAKE_SYS_X_COUNT, FAKE_SYS_Y_COUNT, FAKE_SYS_ALIAS_COUNT)
+
+MC_DEFINE_STATIC_COMPOSITE_DRIVER(fake_static_composite_sys_driver,
+                                  fake_composite_ctx_t,
+                                  FAKE_STATIC_NODE(sys1),
+                                  FAKE_STATIC_NODE(sys2));
@@ -24,7 +24,7 @@ void fake_sys_init(void *ctx)
     data->reset_name = (const char *)DEFAULT_FAKE_RESET_NAME;
 }
 
-mc_status_t fake_sys_invoke(void *ctx, uint8_t func_id, int32_t *args,
+mc_status_t fake_sys_invoke(void *ctx, mc_sys_id_t func_id, int32_t *args,
                             uint8_t arg_count)
 {
     switch (func_id)
@@ -39,26 +39,27 @@ mc_status_t fake_sys_invoke(void *ctx, uint8_t func_id, int32_t *args,
     }
 }
 
-mc_status_t fake_sys_write_input(void *ctx, uint8_t x_id, int32_t val)
+mc_status_t fake_sys_write_input(void *ctx, mc_sys_id_t x_id, int32_t val)
 {
     fake_sys_ctx_t *data = (fake_sys_ctx_t *)ctx;
     data->x[x_id] = val;
     return MC_OK;
 }
 
-mc_result_t fake_sys_read_input(void *ctx, uint8_t x_id)
+mc_result_t fake_sys_read_input(void *ctx, mc_sys_id_t x_id)
 {
     fake_sys_ctx_t *data = (fake_sys_ctx_t *)ctx;
     return MC_OK_VAL(data->x[x_id]);
 }
 
-mc_result_t fake_sys_read_output(void *ctx, uint8_t y_id)
+mc_result_t fake_sys_read_output(void *ctx, mc_sys_id_t y_id)
 {
     fake_sys_ctx_t *data = (fake_sys_ctx_t *)ctx;
     return MC_OK_VAL(data->y[y_id]);
 }
 
-mc_status_t fake_sys_get_alias(void *ctx, uint8_t id, mc_sys_cmd_info_t *info)
+mc_status_t fake_sys_get_alias(void *ctx, mc_sys_id_t id,
+                               mc_sys_cmd_info_t *info)
 {
     fake_sys_ctx_t *data = (fake_sys_ctx_t *)ctx;
     switch (id)
@@ -93,22 +94,22 @@ mc_status_t fake_sys_get_alias(void *ctx, uint8_t id, mc_sys_cmd_info_t *info)
     }
 }
 
-uint8_t fake_sys_get_function_count(void *ctx)
+mc_sys_id_t fake_sys_get_function_count(void *ctx)
 {
     return FAKE_SYS_F_COUNT;
 }
 
-uint8_t fake_sys_get_input_count(void *ctx)
+mc_sys_id_t fake_sys_get_input_count(void *ctx)
 {
     return FAKE_SYS_X_COUNT;
 }
 
-uint8_t fake_sys_get_output_count(void *ctx)
+mc_sys_id_t fake_sys_get_output_count(void *ctx)
 {
     return FAKE_SYS_Y_COUNT;
 }
 
-uint8_t fake_sys_get_alias_count(void *ctx)
+mc_sys_id_t fake_sys_get_alias_count(void *ctx)
 {
     return FAKE_SYS_ALIAS_COUNT;
 }
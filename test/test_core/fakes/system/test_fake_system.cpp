@@ -49,20 +49,20 @@ namespace
         ctx.x[0] = 4;
         ctx.x[1] = 7;
         mc_result_t res = fake_sys_driver.read_input(&ctx, 0);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(4, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(4, MC_RESULT_VALUE(res));
 
         res = fake_sys_driver.read_input(&ctx, 1);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(7, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(7, MC_RESULT_VALUE(res));
     }
 
     TEST_F(FakeSystemTest, ReadOutputSucceeds)
     {
         ctx.y[0] = 5;
         mc_result_t res = fake_sys_driver.read_output(&ctx, 0);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(5, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(5, MC_RESULT_VALUE(res));
     }
 
     TEST_F(FakeSystemTest, InvokeSucceeds)
@@ -59,8 +59,8 @@ namespace
         ctx->target_value = 2495;
         dev_ctx.value = -1323;
         mc_result_t res = mc_sys_read_input(&sys, 0);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(2495, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(2495, MC_RESULT_VALUE(res));
     }
 
     TEST_F(AnalogSystemTest, ReadOutputGetsActualValue)
@@ -69,8 +69,8 @@ namespace
         ctx->target_value = 2495;
         dev_ctx.value = -1323;
         mc_result_t res = mc_sys_read_output(&sys, 0);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(-1323, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(-1323, MC_RESULT_VALUE(res));
     }
 
     TEST_F(AnalogSystemTest, InvokeFunctionFails)
@@ -136,8 +136,8 @@ namespace
     {
         mc_analog_set_read_only(&dev, true);
         mc_result_t res = mc_sys_read_input(&sys, 0);
-        EXPECT_FALSE(res.ok);
-        EXPECT_EQ(MC_ERROR_INVALID_ARGS, res.error);
+        EXPECT_FALSE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS, MC_RESULT_ERROR(res));
     }
 
     TEST_F(AnalogSystemTest, ReadOnlyReadOutputSucceeds)
@@ -145,8 +145,8 @@ namespace
         mc_analog_set_read_only(&dev, true);
         dev_ctx.value = 122;
         mc_result_t res = mc_sys_read_output(&sys, 0);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(122, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(122, MC_RESULT_VALUE(res));
     }
 
     TEST_F(AnalogSystemTest, ReadOnlyInvokeFunctionFails)
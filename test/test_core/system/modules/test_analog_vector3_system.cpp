@@ -80,20 +80,20 @@ namespace
         ctx->x.target_value = 2495;
         dev_ctx.x = -1323;
         mc_result_t res = mc_sys_read_input(&sys, 0);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(2495, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(2495, MC_RESULT_VALUE(res));
 
         ctx->y.target_value = 2496;
         dev_ctx.y = -1322;
         res = mc_sys_read_input(&sys, 1);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(2496, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(2496, MC_RESULT_VALUE(res));
 
         ctx->z.target_value = 2497;
         dev_ctx.z = -1321;
         res = mc_sys_read_input(&sys, 2);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(2497, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(2497, MC_RESULT_VALUE(res));
     }
 
     TEST_F(AnalogVector3SystemTest, ReadOutputGetsActualValue)
@@ -102,20 +102,20 @@ namespace
         ctx->x.target_value = 2495;
         dev_ctx.x = -1323;
         mc_result_t res = mc_sys_read_output(&sys, 0);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(-1323, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(-1323, MC_RESULT_VALUE(res));
 
         ctx->y.target_value = 2496;
         dev_ctx.y = -1322;
         res = mc_sys_read_output(&sys, 1);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(-1322, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(-1322, MC_RESULT_VALUE(res));
 
         ctx->z.target_value = 2497;
         dev_ctx.z = -1321;
         res = mc_sys_read_output(&sys, 2);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(-1321, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(-1321, MC_RESULT_VALUE(res));
     }
 
     TEST_F(AnalogVector3SystemTest, InvokeFunctionFails)
@@ -225,8 +225,8 @@ namespace
     {
         mc_analog_vector3_set_read_only(&dev, true);
         mc_result_t res = mc_sys_read_input(&sys, 0);
-        EXPECT_FALSE(res.ok);
-        EXPECT_EQ(MC_ERROR_INVALID_ARGS, res.error);
+        EXPECT_FALSE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS, MC_RESULT_ERROR(res));
     }
 
     TEST_F(AnalogVector3SystemTest, ReadOnlyReadOutputSucceeds)
@@ -234,18 +234,18 @@ namespace
         mc_analog_vector3_set_read_only(&dev, true);
         dev_ctx.x = 122;
         mc_result_t res = mc_sys_read_output(&sys, 0);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(122, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(122, MC_RESULT_VALUE(res));
 
         dev_ctx.y = 123;
         res = mc_sys_read_output(&sys, 1);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(123, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(123, MC_RESULT_VALUE(res));
 
         dev_ctx.z = 124;
         res = mc_sys_read_output(&sys, 2);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(124, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(124, MC_RESULT_VALUE(res));
     }
 
     TEST_F(AnalogVector3SystemTest, ReadOnlyInvokeFunctionFails)
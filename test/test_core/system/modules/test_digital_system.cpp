@@ -69,14 +69,14 @@ namespace
         ctx->target_state = true;
         dev_ctx.state = false;
         mc_result_t res = mc_sys_read_input(&sys, 0);
-        EXPECT_TRUE(res.ok);
-        EXPECT_TRUE(res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_TRUE(MC_RESULT_VALUE(res));
 
         ctx->target_state = false;
         dev_ctx.state = true;
         res = mc_sys_read_input(&sys, 0);
-        EXPECT_TRUE(res.ok);
-        EXPECT_FALSE(res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_FALSE(MC_RESULT_VALUE(res));
     }
 
     TEST_F(DigitalSystemTest, ReadOutputGetsActualState)
@@ -85,14 +85,14 @@ namespace
         ctx->target_state = true;
         dev_ctx.state = false;
         mc_result_t res = mc_sys_read_output(&sys, 0);
-        EXPECT_TRUE(res.ok);
-        EXPECT_FALSE(res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_FALSE(MC_RESULT_VALUE(res));
 
         ctx->target_state = false;
         dev_ctx.state = true;
         res = mc_sys_read_output(&sys, 0);
-        EXPECT_TRUE(res.ok);
-        EXPECT_TRUE(res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_TRUE(MC_RESULT_VALUE(res));
     }
 
     TEST_F(DigitalSystemTest, InvokeFunctionTogglesState)
@@ -218,8 +218,8 @@ namespace
     {
         mc_digital_set_read_only(&dev, true);
         mc_result_t res = mc_sys_read_input(&sys, 0);
-        EXPECT_FALSE(res.ok);
-        EXPECT_EQ(MC_ERROR_INVALID_ARGS, res.error);
+        EXPECT_FALSE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS, MC_RESULT_ERROR(res));
     }
 
     TEST_F(DigitalSystemTest, ReadOnlyReadOutputSucceeds)
@@ -227,8 +227,8 @@ namespace
         mc_digital_set_read_only(&dev, true);
         dev_ctx.state = false;
         mc_result_t res = mc_sys_read_output(&sys, 0);
-        EXPECT_TRUE(res.ok);
-        EXPECT_FALSE(res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_FALSE(MC_RESULT_VALUE(res));
     }
 
     TEST_F(DigitalSystemTest, ReadOnlyInvokeFunctionFails)
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include "mc_test.h"
+
+extern "C"
+{
+#include "mc/system/core.h"
+#include "mc/system/modules/pid_system.h"
+#include "mc/device/analog.h"
+}
+
+namespace
+{
+
+    // Globals
+    MC_DEFINE_ANALOG_DATA_OBJECT(sensor);
+    MC_DEFINE_ANALOG_DATA_OBJECT(actuator);
+    mc_pid_system_config_t config = MC_PID_SYSTEM_CONFIG(0, 0, 0, -100, 100);
+    MC_DEFINE_PID_SYSTEM(sys, config, sensor, actuator);
+    mc_pid_system_ctx_t *ctx;
+
+    class PidSystemTest : public MeeCoreTest
+    {
+    protected:
+        void SetUp() override
+        {
+            MeeCoreTest::SetUp();
+            ctx = (mc_pid_system_ctx_t *)sys.ctx;
+
+            mc_analog_init(&sensor, /*is_read_only=*/false);
+            mc_analog_init(&actuator, /*is_read_only=*/false);
+            mc_sys_init(&sys);
+        }
+
+        // Sets gains through the system inputs.
+        void SetGains(double kp, double ki, double kd)
+        {
+            mc_sys_write_input(&sys, 1, MC_PID_Q16(kp));
+            mc_sys_write_input(&sys, 2, MC_PID_Q16(ki));
+            mc_sys_write_input(&sys, 3, MC_PID_Q16(kd));
+        }
+    };
+
+    TEST_F(PidSystemTest, InitSetsSetpointToCurrentValue)
+    {
+        sensor_ctx.value = 321;
+        mc_sys_init(&sys);
+        EXPECT_EQ(321, ctx->setpoint);
+    }
+
+    TEST_F(PidSystemTest, HasUpdateCapability)
+    {
+        EXPECT_TRUE(mc_sys_get_capabilities(&sys) & MC_SYS_CAP_UPDATE);
+    }
+
+    TEST_F(PidSystemTest, ProportionalDrivesActuator)
+    {
+        SetGains(2, 0, 0);
+        mc_sys_write_input(&sys, 0, 10);
+
+        EXPECT_EQ(MC_OK, mc_sys_update(&sys, 10));
+        EXPECT_EQ(20, actuator_ctx.value);
+
+        mc_result_t res = mc_sys_read_output(&sys, 1);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(20, MC_RESULT_VALUE(res));
+    }
+
+    TEST_F(PidSystemTest, OutputIsClamped)
+    {
+        SetGains(100, 0, 0);
+        mc_sys_write_input(&sys, 0, 10);
+        mc_sys_update(&sys, 10);
+        EXPECT_EQ(100, actuator_ctx.value);
+
+        mc_sys_write_input(&sys, 0, -10);
+        mc_sys_update(&sys, 10);
+        EXPECT_EQ(-100, actuator_ctx.value);
+    }
+
+    TEST_F(PidSystemTest, IntegralScalesWithDt)
+    {
+        // 1 per second per unit of error
+        SetGains(0, 1, 0);
+        mc_sys_write_input(&sys, 0, 10);
+
+        mc_sys_update(&sys, 100);
+        EXPECT_EQ(1, actuator_ctx.value);
+        mc_sys_update(&sys, 200);
+        EXPECT_EQ(3, actuator_ctx.value);
+    }
+
+    TEST_F(PidSystemTest, IntegralDoesNotWindUp)
+    {
+        SetGains(0, 1, 0);
+        mc_sys_write_input(&sys, 0, 10);
+        for (int i = 0; i < 100; i++)
+        {
+            mc_sys_update(&sys, 1000);
+        }
+        EXPECT_EQ(100, actuator_ctx.value);
+
+        // Recovers right after the error changes sign
+        sensor_ctx.value = 11;
+        mc_sys_update(&sys, 1000);
+        EXPECT_EQ(99, actuator_ctx.value);
+    }
+
+    TEST_F(PidSystemTest, DerivativeActsOnMeasurement)
+    {
+        SetGains(0, 0, 1);
+        mc_sys_update(&sys, 100);
+        EXPECT_EQ(0, actuator_ctx.value);
+
+        // Setpoint step does not kick the output
+        mc_sys_write_input(&sys, 0, 50);
+        mc_sys_update(&sys, 100);
+        EXPECT_EQ(0, actuator_ctx.value);
+
+        // 5 units in 100 ms opposes the change
+        sensor_ctx.value = 5;
+        mc_sys_update(&sys, 100);
+        EXPECT_EQ(-50, actuator_ctx.value);
+    }
+
+    TEST_F(PidSystemTest, ResetClearsIntegral)
+    {
+        SetGains(0, 1, 0);
+        mc_sys_write_input(&sys, 0, 10);
+        mc_sys_update(&sys, 1000);
+        EXPECT_EQ(10, actuator_ctx.value);
+
+        EXPECT_EQ(MC_OK, mc_sys_invoke(&sys, 0, NULL, 0));
+        mc_sys_update(&sys, 100);
+        EXPECT_EQ(1, actuator_ctx.value);
+    }
+
+    TEST_F(PidSystemTest, SensorErrorLeavesActuator)
+    {
+        SetGains(1, 0, 0);
+        mc_sys_write_input(&sys, 0, 10);
+        actuator_ctx.value = 7;
+        sensor_ctx.error = MC_ERROR_NO_RESPONSE;
+
+        EXPECT_EQ(MC_ERROR_NO_RESPONSE, mc_sys_update(&sys, 10));
+        EXPECT_EQ(7, actuator_ctx.value);
+    }
+
+    TEST_F(PidSystemTest, ReadInputGetsGains)
+    {
+        SetGains(1.5, 0, 0);
+        mc_result_t res = mc_sys_read_input(&sys, 1);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(MC_PID_Q16(1.5), MC_RESULT_VALUE(res));
+
+        res = mc_sys_read_input(&sys, 4);
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS, MC_RESULT_ERROR(res));
+    }
+
+    TEST_F(PidSystemTest, GetAliasSucceeds)
+    {
+        mc_sys_cmd_info_t cmd;
+        EXPECT_EQ(MC_OK, mc_sys_get_alias(&sys, 2, &cmd));
+        EXPECT_STREQ("setpoint", cmd.alias);
+        EXPECT_EQ(MC_CMD_TYPE_INPUT, cmd.type);
+        EXPECT_EQ(0, cmd.id);
+
+        EXPECT_EQ(MC_OK, mc_sys_get_alias(&sys, 6, &cmd));
+        EXPECT_STREQ("reset", cmd.alias);
+        EXPECT_EQ(MC_CMD_TYPE_FUNC, cmd.type);
+
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS, mc_sys_get_alias(&sys, 7, &cmd));
+    }
+
+    TEST_F(PidSystemTest, GetMemberCountSucceeds)
+    {
+        EXPECT_EQ(1, mc_sys_get_function_count(&sys));
+        EXPECT_EQ(4, mc_sys_get_input_count(&sys));
+        EXPECT_EQ(2, mc_sys_get_output_count(&sys));
+        EXPECT_EQ(7, mc_sys_get_alias_count(&sys));
+    }
+
+}
@@ -0,0 +1,291 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include "mc_test.h"
+
+extern "C"
+{
+#include "mc/communication/stream.h"
+#include "mc/system/binary_console.h"
+#include "mc/utils.h"
+#include "fakes/communication/fake_stream.h"
+#include "fakes/system/fake_system.h"
+#include "fakes/system/fake_composite.h"
+}
+
+namespace
+{
+
+    // Globals
+    fake_stream_ctx_t stream_ctx;
+    MC_DEFINE_STREAM(stream, fake_stream_driver, stream_ctx, 256, 256,
+                     MC_STREAM_MODE_TEXT_LINE);
+    fake_sys_ctx_t sys_ctx1;
+    MC_DEFINE_SYSTEM(sys1, fake_sys_driver, sys_ctx1);
+    fake_wide_composite_ctx_t wide_ctx;
+    MC_DEFINE_SYSTEM(wide_sys, fake_wide_composite_sys_driver, wide_ctx);
+
+    const mc_system_entry_t systems[] = {
+        MC_SYS_ENTRY(1, sys1, "fake1"),
+        MC_SYS_ENTRY(7, wide_sys, "wide"),
+    };
+
+    MC_DEFINE_SYSTEM_BINARY_CONSOLE(console, stream, systems, 2, 4);
+
+    typedef std::vector<uint8_t> bytes_t;
+
+    class BinaryConsoleTest : public MeeCoreTest
+    {
+    protected:
+        void SetUp() override
+        {
+            MeeCoreTest::SetUp();
+
+            sys_ctx1 = fake_sys_ctx_t{};
+            wide_ctx = fake_wide_composite_ctx_t{};
+            mc_sys_init(&sys1);
+            mc_sys_init(&wide_sys);
+            mc_stream_init(&stream);
+            mc_sys_binary_console_init(&console);
+        }
+
+        // Helper for framing a payload.
+        static bytes_t frame(const bytes_t &payload)
+        {
+            bytes_t out = {MC_SYS_BIN_SYNC, (uint8_t)payload.size()};
+            out.insert(out.end(), payload.begin(), payload.end());
+            uint16_t crc = mc_crc16_update(MC_CRC16_INIT, &out[1],
+                                           payload.size() + 1);
+            out.push_back((uint8_t)crc);
+            out.push_back((uint8_t)(crc >> 8));
+            return out;
+        }
+
+        // Helper for pushing raw bytes and running the stream.
+        void send_bytes(const bytes_t &data)
+        {
+            fake_stream_push_char_array(&stream_ctx, (const char *)data.data(),
+                                        data.size());
+            mc_stream_update(&stream);
+        }
+
+        // Helper for sending a request.
+        void send_request(const bytes_t &payload)
+        {
+            send_bytes(frame(payload));
+        }
+
+        // Helper for getting the payload of the only response sent. Empty if
+        // there is none or the frame is broken.
+        bytes_t response()
+        {
+            bytes_t out(stream_ctx.output_data,
+                        stream_ctx.output_data + stream_ctx.output_index);
+            stream_ctx.output_index = 0;
+            stream_ctx.output_data[0] = '\0';
+            if (out.size() < MC_SYS_BIN_FRAME_OVERHEAD ||
+                out.size() != (size_t)out[1] + MC_SYS_BIN_FRAME_OVERHEAD ||
+                frame(bytes_t(out.begin() + 2, out.end() - 2)) != out)
+            {
+                return bytes_t();
+            }
+            return bytes_t(out.begin() + 2, out.end() - 2);
+        }
+    };
+
+    TEST_F(BinaryConsoleTest, InitSetsIsInitializedField)
+    {
+        EXPECT_EQ(MC_INITIALIZED, console.state->is_initialized);
+        EXPECT_EQ(MC_STREAM_MODE_BINARY_STREAM, stream.state->mode);
+    }
+
+    TEST_F(BinaryConsoleTest, CrcMatchesCheckValue)
+    {
+        EXPECT_EQ(0x29B1, mc_crc16_update(MC_CRC16_INIT, "123456789", 9));
+    }
+
+    TEST_F(BinaryConsoleTest, PingEchoesRequestId)
+    {
+        send_request({42, MC_SYS_BIN_OP_PING});
+        EXPECT_EQ(bytes_t({42, MC_SYS_BIN_RESPONSE | MC_SYS_BIN_OP_PING,
+                           MC_OK}),
+                  response());
+    }
+
+    TEST_F(BinaryConsoleTest, ReadInputSucceeds)
+    {
+        sys_ctx1.x[1] = -3;
+        send_request({1, MC_SYS_BIN_OP_READ_INPUT, 1, 1});
+        // -3 zigzags to 5
+        EXPECT_EQ(bytes_t({1, MC_SYS_BIN_RESPONSE | MC_SYS_BIN_OP_READ_INPUT,
+                           MC_OK, 5}),
+                  response());
+    }
+
+    TEST_F(BinaryConsoleTest, WriteInputSucceeds)
+    {
+        // 300 zigzags to 600, varint 0xD8 0x04
+        send_request({2, MC_SYS_BIN_OP_WRITE_INPUT, 1, 0, 0xD8, 0x04});
+        EXPECT_EQ(bytes_t({2, MC_SYS_BIN_RESPONSE | MC_SYS_BIN_OP_WRITE_INPUT,
+                           MC_OK}),
+                  response());
+        EXPECT_EQ(300, sys_ctx1.x[0]);
+    }
+
+    TEST_F(BinaryConsoleTest, ReadOutputSucceeds)
+    {
+        sys_ctx1.y[0] = 64;
+        send_request({3, MC_SYS_BIN_OP_READ_OUTPUT, 1, 0});
+        EXPECT_EQ(bytes_t({3, MC_SYS_BIN_RESPONSE | MC_SYS_BIN_OP_READ_OUTPUT,
+                           MC_OK, 0x80, 0x01}),
+                  response());
+    }
+
+    TEST_F(BinaryConsoleTest, InvokeWithArgsSucceeds)
+    {
+        send_request({4, MC_SYS_BIN_OP_INVOKE, 1, 0});
+        EXPECT_EQ(bytes_t({4, MC_SYS_BIN_RESPONSE | MC_SYS_BIN_OP_INVOKE,
+                           MC_OK}),
+                  response());
+        EXPECT_EQ(1, sys_ctx1.y[0]);
+
+        // f1 returns its argument as error. 8 zigzags to 16.
+        send_request({5, MC_SYS_BIN_OP_INVOKE, 1, 1, 16});
+        EXPECT_EQ(bytes_t({5, MC_SYS_BIN_RESPONSE | MC_SYS_BIN_OP_INVOKE,
+                           MC_ERROR_NO_RESOURCE}),
+                  response());
+    }
+
+    TEST_F(BinaryConsoleTest, TooManyArgsReturnError)
+    {
+        send_request({6, MC_SYS_BIN_OP_INVOKE, 1, 0, 0, 0, 0, 0, 0});
+        EXPECT_EQ(bytes_t({6, MC_SYS_BIN_RESPONSE | MC_SYS_BIN_OP_INVOKE,
+                           MC_ERROR_INVALID_ARGS}),
+                  response());
+        EXPECT_EQ(0, sys_ctx1.y[0]);
+    }
+
+    TEST_F(BinaryConsoleTest, ReadOutputsSucceeds)
+    {
+        wide_ctx.sys[1].y[0] = 1;
+        wide_ctx.sys[2].y[0] = -1;
+        send_request({7, MC_SYS_BIN_OP_READ_OUTPUTS, 7, 1, 2});
+        EXPECT_EQ(bytes_t({7, MC_SYS_BIN_RESPONSE | MC_SYS_BIN_OP_READ_OUTPUTS,
+                           MC_OK, 2, MC_OK, 2, MC_OK, 1}),
+                  response());
+    }
+
+    TEST_F(BinaryConsoleTest, ReadOutputsPastEndReportErrorPerItem)
+    {
+        mc_sys_id_t last = FAKE_WIDE_COMPOSITE_COUNT - 1;
+        wide_ctx.sys[last].y[0] = 2;
+        send_request({8, MC_SYS_BIN_OP_READ_OUTPUTS, 7, (uint8_t)last, 2});
+        EXPECT_EQ(bytes_t({8, MC_SYS_BIN_RESPONSE | MC_SYS_BIN_OP_READ_OUTPUTS,
+                           MC_OK, 2, MC_OK, 4, MC_ERROR_INVALID_ARGS}),
+                  response());
+    }
+
+    TEST_F(BinaryConsoleTest, ReadOutputsStopsWhenPayloadIsFull)
+    {
+        // Each item takes a status byte and a 5 byte value.
+        for (int i = 0; i < FAKE_WIDE_COMPOSITE_COUNT; i++)
+        {
+            wide_ctx.sys[i].y[0] = INT32_MIN;
+        }
+        send_request({9, MC_SYS_BIN_OP_READ_OUTPUTS, 7, 0,
+                      FAKE_WIDE_COMPOSITE_COUNT});
+        bytes_t res = response();
+        uint8_t fit = std::min((MC_SYS_BIN_MAX_PAYLOAD - 4) / 6,
+                               FAKE_WIDE_COMPOSITE_COUNT);
+        ASSERT_EQ(4u + fit * 6u, res.size());
+        EXPECT_EQ(MC_OK, res[2]);
+        EXPECT_EQ(fit, res[3]);
+        EXPECT_EQ(bytes_t({MC_OK, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F}),
+                  bytes_t(res.end() - 6, res.end()));
+    }
+
+    TEST_F(BinaryConsoleTest, UnknownSystemReturnsError)
+    {
+        send_request({10, MC_SYS_BIN_OP_READ_INPUT, 2, 0});
+        EXPECT_EQ(bytes_t({10, MC_SYS_BIN_RESPONSE | MC_SYS_BIN_OP_READ_INPUT,
+                           MC_ERROR_INVALID_ARGS}),
+                  response());
+    }
+
+    TEST_F(BinaryConsoleTest, TruncatedVarintReturnsError)
+    {
+        send_request({11, MC_SYS_BIN_OP_READ_INPUT, 1, 0x80});
+        EXPECT_EQ(bytes_t({11, MC_SYS_BIN_RESPONSE | MC_SYS_BIN_OP_READ_INPUT,
+                           MC_ERROR_INVALID_ARGS}),
+                  response());
+    }
+
+    TEST_F(BinaryConsoleTest, IdPastMaxIdReturnsError)
+    {
+        // MC_SYS_MAX_ID + 1 as a 3 byte varint
+        uint32_t id = (uint32_t)MC_SYS_MAX_ID + 1;
+        send_request({12, MC_SYS_BIN_OP_READ_INPUT, 1,
+                      (uint8_t)(id | 0x80), (uint8_t)((id >> 7) | 0x80),
+                      (uint8_t)(id >> 14)});
+        EXPECT_EQ(bytes_t({12, MC_SYS_BIN_RESPONSE | MC_SYS_BIN_OP_READ_INPUT,
+                           MC_ERROR_INVALID_ARGS}),
+                  response());
+    }
+
+    TEST_F(BinaryConsoleTest, UnknownOpcodeReturnsError)
+    {
+        send_request({13, 0x7F});
+        EXPECT_EQ(bytes_t({13, MC_SYS_BIN_RESPONSE | 0x7F,
+                           MC_ERROR_NOT_SUPPORTED}),
+                  response());
+    }
+
+    TEST_F(BinaryConsoleTest, BadCrcIsDropped)
+    {
+        bytes_t bad = frame({14, MC_SYS_BIN_OP_WRITE_INPUT, 1, 0, 2});
+        bad.back() ^= 0x01;
+        send_bytes(bad);
+        EXPECT_EQ(bytes_t(), response());
+        EXPECT_EQ(0, sys_ctx1.x[0]);
+        EXPECT_EQ(1, mc_sys_binary_console_get_dropped_count(&console));
+
+        // Next frame still gets through.
+        send_request({15, MC_SYS_BIN_OP_PING});
+        EXPECT_EQ(bytes_t({15, MC_SYS_BIN_RESPONSE | MC_SYS_BIN_OP_PING,
+                           MC_OK}),
+                  response());
+    }
+
+#if MC_SYS_BIN_MAX_PAYLOAD < 255
+    TEST_F(BinaryConsoleTest, OversizedFrameIsDropped)
+    {
+        send_bytes({MC_SYS_BIN_SYNC, MC_SYS_BIN_MAX_PAYLOAD + 1});
+        EXPECT_EQ(1, mc_sys_binary_console_get_dropped_count(&console));
+
+        send_request({16, MC_SYS_BIN_OP_PING});
+        EXPECT_EQ(bytes_t({16, MC_SYS_BIN_RESPONSE | MC_SYS_BIN_OP_PING,
+                           MC_OK}),
+                  response());
+    }
+#endif
+
+    TEST_F(BinaryConsoleTest, FrameSplitOverUpdatesSucceeds)
+    {
+        sys_ctx1.x[0] = 1;
+        bytes_t req = frame({17, MC_SYS_BIN_OP_READ_INPUT, 1, 0});
+        // Noise before the sync byte is skipped.
+        send_bytes({0x00, 0x13});
+        send_bytes(bytes_t(req.begin(), req.begin() + 3));
+        EXPECT_EQ(bytes_t(), response());
+        send_bytes(bytes_t(req.begin() + 3, req.end()));
+        EXPECT_EQ(bytes_t({17, MC_SYS_BIN_RESPONSE | MC_SYS_BIN_OP_READ_INPUT,
+                           MC_OK, 2}),
+                  response());
+    }
+
+    TEST_F(BinaryConsoleTest, AssertDeathIfNull)
+    {
+        EXPECT_ANY_THROW(mc_sys_binary_console_init(NULL));
+        EXPECT_ANY_THROW(mc_sys_binary_console_get_dropped_count(NULL));
+    }
+}
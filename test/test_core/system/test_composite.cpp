@@ -6,6 +6,7 @@ extern "C"
 #include "mc/system/composite.h"
 #include "fakes/system/fake_system.h"
 #include "fakes/system/fake_composite.h"
+#include "mc/device/analog.h"
 }
 
 namespace
@@ -15,6 +16,34 @@ namespace
     fake_composite_ctx_t ctx;
     MC_DEFINE_SYSTEM(sys, fake_composite_sys_driver, ctx);
 
+    // Second instance sharing the driver
+    fake_composite_ctx_t other_ctx;
+    MC_DEFINE_SYSTEM(other_sys, fake_composite_sys_driver, other_ctx);
+
+    // Driver with a table for one instance, used by two
+    fake_composite_ctx_t single_ctx;
+    MC_DEFINE_SYSTEM(single_sys, fake_single_composite_sys_driver, single_ctx);
+    fake_composite_ctx_t other_single_ctx;
+    MC_DEFINE_SYSTEM(other_single_sys, fake_single_composite_sys_driver,
+                     other_single_ctx);
+
+    MC_DEFINE_ANALOG_DATA_OBJECT(dev);
+    fake_mixed_composite_ctx_t mixed_ctx = {
+        .analog = {.device = &dev, .config = &mc_analog_sys_config}};
+    MC_DEFINE_SYSTEM(mixed_sys, fake_mixed_composite_sys_driver, mixed_ctx);
+
+    fake_deep_composite_ctx_t deep_ctx;
+    MC_DEFINE_SYSTEM(deep_sys, fake_deep_composite_sys_driver, deep_ctx);
+
+    fake_wide_composite_ctx_t wide_ctx;
+    MC_DEFINE_SYSTEM(wide_sys, fake_wide_composite_sys_driver, wide_ctx);
+
+    fake_sized_composite_ctx_t sized_ctx;
+    MC_DEFINE_SYSTEM(sized_sys, fake_sized_composite_sys_driver, sized_ctx);
+    fake_sized_composite_ctx_t other_sized_ctx;
+    MC_DEFINE_SYSTEM(other_sized_sys, fake_sized_composite_sys_driver,
+                     other_sized_ctx);
+
     class CompositeTest : public MeeCoreTest
     {
     protected:
@@ -54,12 +83,12 @@ namespace
         ctx.sys1.x[0] = 4;
         ctx.sys2.x[0] = 7;
         mc_result_t res = mc_sys_read_input(&sys, 0);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(4, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(4, MC_RESULT_VALUE(res));
 
         res = mc_sys_read_input(&sys, 2);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(7, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(7, MC_RESULT_VALUE(res));
     }
 
     TEST_F(CompositeTest, ReadOutputSucceeds)
@@ -67,12 +96,53 @@ namespace
         ctx.sys1.y[0] = 5;
         ctx.sys2.y[0] = 2;
         mc_result_t res = mc_sys_read_output(&sys, 0);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(5, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(5, MC_RESULT_VALUE(res));
 
         res = mc_sys_read_output(&sys, 1);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(2, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(2, MC_RESULT_VALUE(res));
+    }
+
+    TEST_F(CompositeTest, ReadOutputsSpansChildren)
+    {
+        ctx.sys1.y[0] = 5;
+        ctx.sys2.y[0] = 2;
+        int32_t values[3] = {0};
+        mc_status_t errors[3];
+        mc_status_t ret = mc_sys_read_outputs(&sys, 0, 3, values, errors);
+
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS, ret);
+        EXPECT_EQ(5, values[0]);
+        EXPECT_EQ(2, values[1]);
+        EXPECT_EQ(MC_OK, errors[0]);
+        EXPECT_EQ(MC_OK, errors[1]);
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS, errors[2]);
+    }
+
+    TEST_F(CompositeTest, WriteInputsSpansChildren)
+    {
+        int32_t values[3] = {3, 8, 9};
+        mc_status_t ret = mc_sys_write_inputs(&sys, 1, 3, values, NULL);
+
+        EXPECT_EQ(MC_OK, ret);
+        EXPECT_EQ(3, ctx.sys1.x[1]);
+        EXPECT_EQ(8, ctx.sys2.x[0]);
+        EXPECT_EQ(9, ctx.sys2.x[1]);
+    }
+
+    TEST_F(CompositeTest, CommitInputsRoutesToChildren)
+    {
+        mc_sys_id_t ids[3] = {2, 0, 3};
+        int32_t values[3] = {5, 6, 7};
+        mc_status_t errors[3];
+        mc_status_t ret = mc_sys_commit_inputs(&sys, 3, ids, values, errors);
+
+        EXPECT_EQ(MC_OK, ret);
+        EXPECT_EQ(5, ctx.sys2.x[0]);
+        EXPECT_EQ(6, ctx.sys1.x[0]);
+        EXPECT_EQ(7, ctx.sys2.x[1]);
+        EXPECT_EQ(MC_OK, errors[2]);
     }
 
     TEST_F(CompositeTest, InvokeSucceeds)
@@ -90,6 +160,21 @@ namespace
         EXPECT_EQ(1, ctx.sys2.y[0]);
     }
 
+    TEST_F(CompositeTest, UpdateNotSupportedWithoutUpdatingChildren)
+    {
+        EXPECT_FALSE(mc_sys_get_capabilities(&sys) & MC_SYS_CAP_UPDATE);
+        EXPECT_EQ(MC_ERROR_NOT_SUPPORTED, mc_sys_update(&sys, 10));
+    }
+
+    TEST_F(CompositeTest, UpdateReachesUpdatingChildren)
+    {
+        sized_ctx = fake_sized_composite_ctx_t{};
+        mc_sys_init(&sized_sys);
+        EXPECT_TRUE(mc_sys_get_capabilities(&sized_sys) & MC_SYS_CAP_UPDATE);
+        EXPECT_EQ(MC_OK, mc_sys_update(&sized_sys, 10));
+        EXPECT_EQ(1u, sized_ctx.sized.update_calls);
+    }
+
     TEST_F(CompositeTest, GetCountsSucceeds)
     {
         EXPECT_EQ(4, mc_sys_get_function_count(&sys));
@@ -174,4 +259,151 @@ namespace
         EXPECT_EQ(MC_ERROR_INVALID_ARGS, ret);
     }
 
-}
\ No newline at end of file
+    TEST_F(CompositeTest, InstancesSharingDriverDispatchToOwnContext)
+    {
+        mc_sys_init(&other_sys);
+
+        mc_sys_write_input(&sys, 2, 5);
+        mc_sys_write_input(&other_sys, 2, 6);
+        mc_sys_write_input(&sys, 3, 7);
+
+        EXPECT_EQ(5, ctx.sys2.x[0]);
+        EXPECT_EQ(7, ctx.sys2.x[1]);
+        EXPECT_EQ(6, other_ctx.sys2.x[0]);
+    }
+
+    TEST_F(CompositeTest, InstancesSharingDriverKeepTheirOwnTables)
+    {
+        sized_ctx = fake_sized_composite_ctx_t{};
+        other_sized_ctx = fake_sized_composite_ctx_t{};
+        sized_ctx.sized.input_count = 1;
+        other_sized_ctx.sized.input_count = 3;
+        mc_sys_init(&sized_sys);
+        mc_sys_init(&other_sized_sys);
+        mc_sys_write_input(&sized_sys, FAKE_SYS_X_COUNT, 0);
+        mc_sys_write_input(&other_sized_sys, FAKE_SYS_X_COUNT, 0);
+        uint32_t calls = sized_ctx.sized.count_calls;
+        uint32_t other_calls = other_sized_ctx.sized.count_calls;
+
+        // Taking turns must not rebuild the tables.
+        for (int i = 0; i < 3; i++)
+        {
+            EXPECT_EQ(MC_OK, mc_sys_write_input(&sized_sys,
+                                                FAKE_SYS_X_COUNT, i));
+            EXPECT_EQ(MC_OK, mc_sys_write_input(&other_sized_sys,
+                                                FAKE_SYS_X_COUNT + 2, i));
+        }
+        EXPECT_EQ(calls, sized_ctx.sized.count_calls);
+        EXPECT_EQ(other_calls, other_sized_ctx.sized.count_calls);
+
+        // Each instance keeps its own member count.
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS,
+                  mc_sys_write_input(&sized_sys, FAKE_SYS_X_COUNT + 2, 9));
+        EXPECT_EQ(2, sized_ctx.sized.last_val);
+        EXPECT_EQ(2, other_sized_ctx.sized.last_x_id);
+    }
+
+    TEST_F(CompositeTest, InstancesPastTableCountAssert)
+    {
+        mc_sys_init(&single_sys);
+        EXPECT_EQ(MC_OK, mc_sys_write_input(&single_sys, 0, 1));
+        EXPECT_ANY_THROW(mc_sys_init(&other_single_sys));
+    }
+
+    TEST_F(CompositeTest, NestedCompositesTakeNoTable)
+    {
+        mc_sys_init(&deep_sys);
+        EXPECT_EQ(MC_OK, mc_sys_write_input(&deep_sys, 0, 1));
+
+        const mc_composite_driver_t *nested =
+            &fake_nested_composite_sys_driver_composite;
+        const mc_composite_driver_t *pair = &fake_composite_sys_driver_composite;
+        for (uint8_t i = 0; i < nested->cache_count; i++)
+        {
+            EXPECT_NE((const void *)&deep_ctx.nested, nested->caches[i].ctx);
+        }
+        for (uint8_t i = 0; i < pair->cache_count; i++)
+        {
+            EXPECT_NE((const void *)&deep_ctx.nested.pair, pair->caches[i].ctx);
+        }
+    }
+
+    TEST_F(CompositeTest, OffsetsFollowReadOnlyChanges)
+    {
+        mc_analog_init(&dev, /*is_read_only=*/false);
+        mc_sys_init(&mixed_sys);
+        EXPECT_EQ(1 + FAKE_SYS_X_COUNT, mc_sys_get_input_count(&mixed_sys));
+        mc_sys_write_input(&mixed_sys, 1, 4);
+        EXPECT_EQ(4, mixed_ctx.sys.x[0]);
+
+        // Analog child loses its input, the test_system moves down.
+        mc_analog_set_read_only(&dev, true);
+        EXPECT_EQ(FAKE_SYS_X_COUNT, mc_sys_get_input_count(&mixed_sys));
+        mc_sys_write_input(&mixed_sys, 1, 9);
+        EXPECT_EQ(9, mixed_ctx.sys.x[1]);
+
+        mc_sys_cmd_info_t cmd;
+        EXPECT_EQ(MC_OK, mc_sys_get_alias(&mixed_sys, 1, &cmd));
+        EXPECT_EQ(MC_CMD_TYPE_FUNC, cmd.type);
+        EXPECT_EQ(0, cmd.id);
+    }
+
+    TEST_F(CompositeTest, NestedCompositesAreFlattened)
+    {
+        mc_sys_init(&deep_sys);
+        // first, pair.sys1, pair.sys2, single
+        EXPECT_EQ(4 * FAKE_SYS_X_COUNT, mc_sys_get_input_count(&deep_sys));
+        EXPECT_EQ(4 * FAKE_SYS_ALIAS_COUNT, mc_sys_get_alias_count(&deep_sys));
+
+        EXPECT_EQ(MC_OK, mc_sys_write_input(&deep_sys, 5, 3));
+        EXPECT_EQ(MC_OK, mc_sys_write_input(&deep_sys, 6, 4));
+        EXPECT_EQ(3, deep_ctx.nested.pair.sys2.x[1]);
+        EXPECT_EQ(4, deep_ctx.nested.single.x[0]);
+
+        EXPECT_EQ(MC_OK, mc_sys_invoke(&deep_sys, 4, NULL, 0));
+        EXPECT_EQ(1, deep_ctx.nested.pair.sys2.y[0]);
+        mc_result_t res = mc_sys_read_output(&deep_sys, 2);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(1, MC_RESULT_VALUE(res));
+
+        // Alias of single gets its id shifted past both levels
+        deep_ctx.nested.single.x0_name = "singleInput";
+        mc_sys_cmd_info_t cmd;
+        EXPECT_EQ(MC_OK, mc_sys_get_alias(&deep_sys, 13, &cmd));
+        EXPECT_STREQ("singleInput", cmd.alias);
+        EXPECT_EQ(6, cmd.id);
+    }
+
+    TEST_F(CompositeTest, MoreThanTenChildren)
+    {
+        mc_sys_init(&wide_sys);
+        EXPECT_EQ(FAKE_WIDE_COMPOSITE_COUNT * FAKE_SYS_X_COUNT,
+                  mc_sys_get_input_count(&wide_sys));
+
+        mc_sys_id_t last = FAKE_WIDE_COMPOSITE_COUNT * FAKE_SYS_X_COUNT - 1;
+        EXPECT_EQ(MC_OK, mc_sys_write_input(&wide_sys, last, 9));
+        EXPECT_EQ(9, wide_ctx.sys[FAKE_WIDE_COMPOSITE_COUNT - 1].x[1]);
+    }
+
+    TEST_F(CompositeTest, MembersUpToMaxIdAreReachable)
+    {
+        mc_sys_init(&sized_sys);
+        sized_ctx.sized.input_count = MC_SYS_MAX_ID - FAKE_SYS_X_COUNT;
+        mc_sys_invalidate(&sized_sys);
+        EXPECT_EQ(MC_SYS_MAX_ID, mc_sys_get_input_count(&sized_sys));
+
+        EXPECT_EQ(MC_OK, mc_sys_write_input(&sized_sys, MC_SYS_MAX_ID - 1, 7));
+        EXPECT_EQ(MC_SYS_MAX_ID - FAKE_SYS_X_COUNT - 1,
+                  sized_ctx.sized.last_x_id);
+        EXPECT_EQ(7, sized_ctx.sized.last_val);
+    }
+
+    TEST_F(CompositeTest, AssertDeathIfMembersExceedMaxId)
+    {
+        mc_sys_init(&sized_sys);
+        sized_ctx.sized.input_count = MC_SYS_MAX_ID - FAKE_SYS_X_COUNT + 1;
+        mc_sys_invalidate(&sized_sys);
+        EXPECT_ANY_THROW(mc_sys_get_input_count(&sized_sys));
+    }
+
+}
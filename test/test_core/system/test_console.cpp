@@ -4,6 +4,7 @@ extern "C"
 {
 #include "mc/communication/stream.h"
 #include "mc/system/console.h"
+#include "mc/system/registry.h"
 #include "fakes/communication/fake_stream.h"
 #include "fakes/system/fake_system.h"
 #include "fakes/system/fake_composite.h"
@@ -31,6 +32,26 @@ namespace
 
     MC_DEFINE_SYSTEM_CONSOLE(console, stream, systems, 3, 8, 5);
 
+    // Console whose alias index only fits two aliases
+    fake_stream_ctx_t small_stream_ctx;
+    MC_DEFINE_STREAM(small_stream, fake_stream_driver, small_stream_ctx, 256,
+                     256, MC_STREAM_MODE_TEXT_LINE);
+    MC_DEFINE_SYSTEM_CONSOLE_WITH_ALIASES(small_console, small_stream, systems,
+                                          3, 8, 5, 2);
+
+    // Console that looks systems up through a registry
+#define REGISTRY_SYSTEMS(X) \
+    X(pump, sys1)           \
+    X(valve, sys2)
+
+    MC_DECLARE_SYSTEM_IDS(REGISTRY_SYSTEMS);
+    MC_DEFINE_SYSTEM_REGISTRY(registry, REGISTRY_SYSTEMS);
+    fake_stream_ctx_t registry_stream_ctx;
+    MC_DEFINE_STREAM(registry_stream, fake_stream_driver, registry_stream_ctx,
+                     256, 256, MC_STREAM_MODE_TEXT_LINE);
+    MC_DEFINE_SYSTEM_CONSOLE_WITH_REGISTRY(registry_console, registry_stream,
+                                           registry, 8, 5);
+
     class ConsoleTest : public MeeCoreTest
     {
     protected:
@@ -43,6 +64,11 @@ namespace
             mc_sys_init(&sys3);
             mc_stream_init(&stream);
             mc_sys_console_init(&console);
+            mc_stream_init(&small_stream);
+            mc_sys_console_init(&small_console);
+            mc_sys_registry_init(&registry);
+            mc_stream_init(&registry_stream);
+            mc_sys_console_init(&registry_console);
         }
 
         // Helper for sending a command.
@@ -160,6 +186,52 @@ namespace
         EXPECT_EQ(4, sys_ctx3.sys2.x[0]);
     }
 
+    TEST_F(ConsoleTest, RenamedAliasGetsFound)
+    {
+        send_command("s1.input = 2");
+        EXPECT_EQ(2, sys_ctx1.x[0]);
+
+        // The alias index still has the old name
+        sys_ctx1.x0_name = "level";
+        stream_ctx.output_index = 0;
+        stream_ctx.output_data[0] = '\0';
+        send_command("s1.level = 3");
+        EXPECT_STREQ(
+            "\x02\n"
+            "s1.level = 3\n"
+            "0\n"
+            "\x03",
+            stream_ctx.output_data);
+        EXPECT_EQ(3, sys_ctx1.x[0]);
+
+        stream_ctx.output_index = 0;
+        stream_ctx.output_data[0] = '\0';
+        send_command("s1.input = 4");
+        EXPECT_STREQ(
+            "\x02\n"
+            "s1.input = 4\n"
+            "E2\n" // Invalid args
+            "\x03",
+            stream_ctx.output_data);
+        EXPECT_EQ(3, sys_ctx1.x[0]);
+    }
+
+    TEST_F(ConsoleTest, AliasesPastIndexSizeGetFound)
+    {
+        // Aliases of s3 come after the first two of s1
+        fake_stream_push_string(&small_stream_ctx, "s3.reset\n");
+        sys_ctx3.sys2.x[0] = 5;
+        sys_ctx3.sys1.x[0] = 5;
+        mc_stream_update(&small_stream);
+        EXPECT_STREQ(
+            "\x02\n"
+            "s3.reset\n"
+            "0\n"
+            "\x03",
+            small_stream_ctx.output_data);
+        EXPECT_EQ(0, sys_ctx3.sys1.x[0]);
+    }
+
     TEST_F(ConsoleTest, AliasWithPresetValueSucceed)
     {
         sys_ctx1.x[0] = 5;
@@ -218,6 +290,102 @@ namespace
             stream_ctx.output_data);
     }
 
+    TEST_F(ConsoleTest, IdsPastMaxIdReturnError)
+    {
+        // Would wrap around to s1 and x0
+        send_command("s65537.x0");
+        EXPECT_STREQ(
+            "\x02\n"
+            "s65537.x0\n"
+            "E2\n" // Invalid args
+            "\x03",
+            stream_ctx.output_data);
+
+        // Reset stream output buffer
+        stream_ctx.output_index = 0;
+        stream_ctx.output_data[0] = '\0';
+        send_command("s1.x65536");
+        EXPECT_STREQ(
+            "\x02\n"
+            "s1.x65536\n"
+            "E2\n" // Invalid args
+            "\x03",
+            stream_ctx.output_data);
+
+        // Would wrap around to the last ID
+        stream_ctx.output_index = 0;
+        stream_ctx.output_data[0] = '\0';
+        send_command("s1.x-1");
+        EXPECT_STREQ(
+            "\x02\n"
+            "s1.x-1\n"
+            "E2\n" // Invalid args
+            "\x03",
+            stream_ctx.output_data);
+    }
+
+    TEST_F(ConsoleTest, PartialSystemNameReturnsError)
+    {
+        send_command("fake.x0");
+        EXPECT_STREQ(
+            "\x02\n"
+            "fake.x0\n"
+            "E2\n" // Invalid args
+            "\x03",
+            stream_ctx.output_data);
+
+        stream_ctx.output_index = 0;
+        stream_ctx.output_data[0] = '\0';
+        send_command("fake22.x0");
+        EXPECT_STREQ(
+            "\x02\n"
+            "fake22.x0\n"
+            "E2\n" // Invalid args
+            "\x03",
+            stream_ctx.output_data);
+    }
+
+    TEST_F(ConsoleTest, RegistryResolvesNamesAndIds)
+    {
+        sys_ctx2.x[0] = 6;
+        fake_stream_push_string(&registry_stream_ctx, "valve.x0\n");
+        mc_stream_update(&registry_stream);
+        EXPECT_STREQ(
+            "\x02\n"
+            "valve.x0\n"
+            "6\n"
+            "\x03",
+            registry_stream_ctx.output_data);
+
+        registry_stream_ctx.output_index = 0;
+        registry_stream_ctx.output_data[0] = '\0';
+        fake_stream_push_string(&registry_stream_ctx, "s0.x0 = 7\n");
+        mc_stream_update(&registry_stream);
+        EXPECT_EQ(7, sys_ctx1.x[0]);
+
+        registry_stream_ctx.output_index = 0;
+        registry_stream_ctx.output_data[0] = '\0';
+        fake_stream_push_string(&registry_stream_ctx, "pum.x0\n");
+        mc_stream_update(&registry_stream);
+        EXPECT_STREQ(
+            "\x02\n"
+            "pum.x0\n"
+            "E2\n" // Invalid args
+            "\x03",
+            registry_stream_ctx.output_data);
+
+        registry_stream_ctx.output_index = 0;
+        registry_stream_ctx.output_data[0] = '\0';
+        fake_stream_push_string(&registry_stream_ctx, "s2.x0\n");
+        mc_stream_update(&registry_stream);
+        EXPECT_STREQ(
+            "\x02\n"
+            "s2.x0\n"
+            "E2\n" // Invalid args
+            "\x03",
+            registry_stream_ctx.output_data);
+    }
+
     TEST_F(ConsoleTest, InvalidAliasReturnsError)
     {
         send_command("s1.myFunction");
@@ -250,6 +418,35 @@ namespace
             stream_ctx.output_data);
     }
 
+#if MC_EVENT_PROFILING
+    TEST_F(ConsoleTest, ProfileCommandPrintsEventStats)
+    {
+        mc_event_profile_register(&stream.state->rx_event, "rx");
+        send_command("prof");
+        mc_list_remove(mc_event_profile_get_events(),
+                       &stream.state->rx_event.profile_node);
+
+        /* Response should look like:
+         * <STX>
+         * prof
+         * event  cb  calls  min_us  avg_us  max_us
+         * rx     -   1
+         *        0   0      0       0       0
+         * <ETX>
+         * Console callback stats are recorded after it returns, so its own
+         * call is not counted yet.
+         */
+        EXPECT_STREQ(
+            "\x02\n"
+            "prof\n"
+            "event\tcb\tcalls\tmin_us\tavg_us\tmax_us\n"
+            "rx\t-\t1\n"
+            "\t0\t0\t0\t0\t0\n"
+            "\x03",
+            stream_ctx.output_data);
+    }
+#endif
+
     TEST_F(ConsoleTest, DumpSucceeds)
     {
         sys_ctx1.x[0] = 0;
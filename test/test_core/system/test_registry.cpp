@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "mc_test.h"
+
+extern "C"
+{
+#include "mc/system/core.h"
+#include "mc/system/registry.h"
+#include "mc/system/snapshot.h"
+#include "fakes/system/fake_system.h"
+}
+
+namespace
+{
+    // Globals
+    fake_sys_ctx_t ctx1;
+    fake_sys_ctx_t ctx2;
+    fake_sys_ctx_t ctx3;
+    MC_DEFINE_SYSTEM(sys1, fake_sys_driver, ctx1);
+    MC_DEFINE_SYSTEM(sys2, fake_sys_driver, ctx2);
+    MC_DEFINE_SYSTEM(sys3, fake_sys_driver, ctx3);
+
+#define TEST_SYSTEMS(X) \
+    X(led, sys1)        \
+    X(motor, sys2)      \
+    X(motor2, sys3)
+
+    MC_DECLARE_SYSTEM_IDS(TEST_SYSTEMS);
+    MC_DEFINE_SYSTEM_REGISTRY(registry, TEST_SYSTEMS);
+    MC_DEFINE_SNAPSHOT(snap, 9, TEST_SYSTEMS(MC_SYS_REGISTRY_POINTER));
+
+    class RegistryTest : public MeeCoreTest
+    {
+    protected:
+        void SetUp() override
+        {
+            MeeCoreTest::SetUp();
+            mc_sys_registry_init(&registry);
+        }
+    };
+
+    TEST_F(RegistryTest, IdsFollowListOrder)
+    {
+        EXPECT_EQ(0, MC_SYS_ID_led);
+        EXPECT_EQ(1, MC_SYS_ID_motor);
+        EXPECT_EQ(2, MC_SYS_ID_motor2);
+        EXPECT_EQ(3, MC_SYS_ID_COUNT);
+        EXPECT_EQ(3, registry.count);
+        EXPECT_STREQ("motor", registry_entries[MC_SYS_ID_motor].name);
+    }
+
+    TEST_F(RegistryTest, GetReturnsEntryById)
+    {
+        const mc_system_entry_t *entry =
+            mc_sys_registry_get(&registry, MC_SYS_ID_motor);
+        ASSERT_TRUE(entry != NULL);
+        EXPECT_EQ(&sys2, entry->system);
+        EXPECT_TRUE(mc_sys_registry_get(&registry, 3) == NULL);
+    }
+
+    TEST_F(RegistryTest, FindReturnsEntryByName)
+    {
+        const char *cmd = "motor2.x0";
+        const mc_system_entry_t *entry = mc_sys_registry_find(&registry, cmd, 6);
+        ASSERT_TRUE(entry != NULL);
+        EXPECT_EQ(MC_SYS_ID_motor2, entry->id);
+
+        // Prefix of a longer name
+        entry = mc_sys_registry_find(&registry, cmd, 5);
+        ASSERT_TRUE(entry != NULL);
+        EXPECT_EQ(MC_SYS_ID_motor, entry->id);
+
+        EXPECT_TRUE(mc_sys_registry_find(&registry, "mot", 3) == NULL);
+        EXPECT_TRUE(mc_sys_registry_find(&registry, "", 0) == NULL);
+    }
+
+    TEST_F(RegistryTest, ListFeedsSnapshot)
+    {
+        EXPECT_EQ(3, snap.system_count);
+        EXPECT_EQ(&sys3, snap.systems[MC_SYS_ID_motor2]);
+    }
+
+    TEST_F(RegistryTest, AssertDeathIfNull)
+    {
+        EXPECT_ANY_THROW(mc_sys_registry_init(NULL));
+        EXPECT_ANY_THROW(mc_sys_registry_get(NULL, 0));
+        EXPECT_ANY_THROW(mc_sys_registry_find(NULL, "led", 3));
+        EXPECT_ANY_THROW(mc_sys_registry_find(&registry, NULL, 0));
+    }
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "mc_test.h"
+
+extern "C"
+{
+#include "mc/system/core.h"
+#include "mc/system/scheduler.h"
+#include "mc/time.h"
+#include "fakes/fake_time.h"
+#include "fakes/system/fake_system.h"
+}
+
+namespace
+{
+
+    // Updates seen by the driver below.
+    uint32_t update_count;
+    uint32_t total_dt_ms;
+    mc_status_t count_updates(void *ctx, uint32_t dt_ms)
+    {
+        (void)ctx;
+        update_count++;
+        total_dt_ms += dt_ms;
+        return MC_OK;
+    }
+
+    // Globals
+    fake_time_ctx_t time_ctx;
+    fake_sys_ctx_t sys_ctx;
+    mc_system_driver_t update_driver;
+    MC_DEFINE_SYSTEM(sys, update_driver, sys_ctx);
+    MC_DEFINE_SYS_TASK(task, sys, 10);
+    MC_DEFINE_SYS_TASK(slow_task, sys, 25);
+
+    class SchedulerTest : public MeeCoreTest
+    {
+    protected:
+        void SetUp() override
+        {
+            MeeCoreTest::SetUp();
+            mc_time_init(&fake_time_driver, &time_ctx);
+            update_driver = fake_sys_driver;
+            update_driver.update = count_updates;
+            mc_sys_init(&sys);
+            update_count = 0;
+            total_dt_ms = 0;
+            mc_sys_task_start(&task);
+        }
+
+        void TearDown() override
+        {
+            mc_sys_task_stop(&task);
+            MeeCoreTest::TearDown();
+        }
+    };
+
+    TEST_F(SchedulerTest, RunsOnlyWhenDue)
+    {
+        fake_time_set_ms(&time_ctx, 9);
+        EXPECT_EQ(0, mc_sys_tasks_run());
+        EXPECT_EQ(0, update_count);
+
+        fake_time_set_ms(&time_ctx, 10);
+        EXPECT_EQ(1, mc_sys_tasks_run());
+        EXPECT_EQ(1, update_count);
+        EXPECT_EQ(10, total_dt_ms);
+
+        // Not due again within the same period
+        EXPECT_EQ(0, mc_sys_tasks_run());
+    }
+
+    TEST_F(SchedulerTest, DeadlinesDoNotDriftWithJitter)
+    {
+        fake_time_set_ms(&time_ctx, 13);
+        mc_sys_tasks_run();
+
+        // Next deadline is 20, not 23
+        fake_time_set_ms(&time_ctx, 20);
+        EXPECT_EQ(1, mc_sys_tasks_run());
+        EXPECT_EQ(2, update_count);
+        EXPECT_EQ(20, total_dt_ms);
+        EXPECT_EQ(0, mc_sys_task_get_overrun_count(&task));
+    }
+
+    TEST_F(SchedulerTest, MissedPeriodsAreSkippedAndCounted)
+    {
+        fake_time_set_ms(&time_ctx, 35);
+        EXPECT_EQ(1, mc_sys_tasks_run());
+        EXPECT_EQ(35, total_dt_ms);
+        EXPECT_EQ(2, mc_sys_task_get_overrun_count(&task));
+
+        // Back on the original grid
+        fake_time_set_ms(&time_ctx, 39);
+        EXPECT_EQ(0, mc_sys_tasks_run());
+        fake_time_set_ms(&time_ctx, 40);
+        EXPECT_EQ(1, mc_sys_tasks_run());
+    }
+
+    TEST_F(SchedulerTest, HandlesTimeWrap)
+    {
+        mc_sys_task_stop(&task);
+        fake_time_set_ms(&time_ctx, UINT32_MAX - 4);
+        mc_sys_task_start(&task);
+
+        fake_time_set_ms(&time_ctx, 4);
+        EXPECT_EQ(0, mc_sys_tasks_run());
+        fake_time_set_ms(&time_ctx, 5);
+        EXPECT_EQ(1, mc_sys_tasks_run());
+        EXPECT_EQ(10, total_dt_ms);
+    }
+
+    TEST_F(SchedulerTest, RunsTasksWithDifferentPeriods)
+    {
+        mc_sys_task_start(&slow_task);
+        fake_time_set_ms(&time_ctx, 25);
+        EXPECT_EQ(2, mc_sys_tasks_run());
+        mc_sys_task_stop(&slow_task);
+    }
+
+    TEST_F(SchedulerTest, StoppedTaskDoesNotRun)
+    {
+        mc_sys_task_stop(&task);
+        fake_time_set_ms(&time_ctx, 100);
+        EXPECT_EQ(0, mc_sys_tasks_run());
+        mc_sys_task_start(&task);
+    }
+
+    TEST_F(SchedulerTest, AssertDeathIfNull)
+    {
+        EXPECT_ANY_THROW(mc_sys_task_start(NULL));
+        EXPECT_ANY_THROW(mc_sys_task_stop(NULL));
+        EXPECT_ANY_THROW(mc_sys_task_get_overrun_count(NULL));
+    }
+
+    TEST_F(SchedulerTest, AssertDeathIfStartedTwice)
+    {
+        EXPECT_ANY_THROW(mc_sys_task_start(&task));
+    }
+
+} // namespace
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "mc_test.h"
+
+extern "C"
+{
+#include "mc/system/core.h"
+#include "mc/system/snapshot.h"
+#include "fakes/system/fake_system.h"
+}
+
+namespace
+{
+    // Globals. Each fake system has 2 inputs and 1 output.
+    fake_sys_ctx_t ctx1;
+    fake_sys_ctx_t ctx2;
+    MC_DEFINE_SYSTEM(sys1, fake_sys_driver, ctx1);
+    MC_DEFINE_SYSTEM(sys2, fake_sys_driver, ctx2);
+    MC_DEFINE_SNAPSHOT(snap, 6, &sys1, &sys2);
+    MC_DEFINE_SNAPSHOT(small_snap, 4, &sys1, &sys2);
+
+    class SnapshotTest : public MeeCoreTest
+    {
+    protected:
+        void SetUp() override
+        {
+            MeeCoreTest::SetUp();
+            mc_sys_init(&sys1);
+            mc_sys_init(&sys2);
+            mc_snapshot_init(&snap);
+            mc_snapshot_init(&small_snap);
+        }
+    };
+
+    TEST_F(SnapshotTest, NothingReadableBeforeCapture)
+    {
+        EXPECT_EQ(0, mc_snapshot_get_sequence(&snap));
+        mc_result_t res = mc_snapshot_read_output(&snap, 0, 0);
+        EXPECT_FALSE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS, MC_RESULT_ERROR(res));
+    }
+
+    TEST_F(SnapshotTest, CaptureCopiesAllMembers)
+    {
+        ctx1.x[0] = 1;
+        ctx1.x[1] = 2;
+        ctx1.y[0] = 3;
+        ctx2.x[0] = 4;
+        ctx2.x[1] = 5;
+        ctx2.y[0] = 6;
+        EXPECT_EQ(MC_OK, mc_snapshot_capture(&snap));
+        EXPECT_EQ(1, mc_snapshot_get_sequence(&snap));
+
+        mc_result_t res = mc_snapshot_read_input(&snap, 0, 1);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(2, MC_RESULT_VALUE(res));
+        res = mc_snapshot_read_output(&snap, 1, 0);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(6, MC_RESULT_VALUE(res));
+
+        mc_sys_id_t count;
+        const int32_t *inputs = mc_snapshot_get_inputs(&snap, 1, &count);
+        EXPECT_EQ(2, count);
+        EXPECT_EQ(4, inputs[0]);
+        EXPECT_EQ(5, inputs[1]);
+        const int32_t *outputs = mc_snapshot_get_outputs(&snap, 0, &count);
+        EXPECT_EQ(1, count);
+        EXPECT_EQ(3, outputs[0]);
+    }
+
+    TEST_F(SnapshotTest, ReadersSeeLastCaptureOnly)
+    {
+        ctx1.y[0] = 3;
+        mc_snapshot_capture(&snap);
+
+        // Live value changes, snapshot does not
+        ctx1.y[0] = 7;
+        EXPECT_EQ(3, MC_RESULT_VALUE(mc_snapshot_read_output(&snap, 0, 0)));
+
+        mc_snapshot_capture(&snap);
+        EXPECT_EQ(7, MC_RESULT_VALUE(mc_snapshot_read_output(&snap, 0, 0)));
+        EXPECT_EQ(2, mc_snapshot_get_sequence(&snap));
+    }
+
+    TEST_F(SnapshotTest, OutOfRangeMemberIsInvalid)
+    {
+        mc_snapshot_capture(&snap);
+        mc_result_t res = mc_snapshot_read_input(&snap, 0, 2);
+        EXPECT_FALSE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS, MC_RESULT_ERROR(res));
+    }
+
+    TEST_F(SnapshotTest, SystemsThatDoNotFitAreLeftOut)
+    {
+        ctx1.y[0] = 3;
+        EXPECT_EQ(MC_ERROR_NO_RESOURCE, mc_snapshot_capture(&small_snap));
+
+        EXPECT_EQ(3,
+                  MC_RESULT_VALUE(mc_snapshot_read_output(&small_snap, 0, 0)));
+        mc_sys_id_t count;
+        mc_snapshot_get_outputs(&small_snap, 1, &count);
+        EXPECT_EQ(0, count);
+    }
+
+    TEST_F(SnapshotTest, AssertDeathIfNull)
+    {
+        mc_sys_id_t count;
+        EXPECT_ANY_THROW(mc_snapshot_init(NULL));
+        EXPECT_ANY_THROW(mc_snapshot_capture(NULL));
+        EXPECT_ANY_THROW(mc_snapshot_get_sequence(NULL));
+        EXPECT_ANY_THROW(mc_snapshot_read_input(NULL, 0, 0));
+        EXPECT_ANY_THROW(mc_snapshot_read_output(NULL, 0, 0));
+        EXPECT_ANY_THROW(mc_snapshot_get_inputs(NULL, 0, &count));
+        EXPECT_ANY_THROW(mc_snapshot_get_outputs(&snap, 0, NULL));
+        EXPECT_ANY_THROW(mc_snapshot_read_output(&snap, 2, 0));
+    }
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "mc_test.h"
+
+extern "C"
+{
+#include "mc/system/core.h"
+#include "mc/system/static_composite.h"
+#include "fakes/system/fake_system.h"
+#include "fakes/system/fake_composite.h"
+}
+
+namespace
+{
+
+    // Globals
+    fake_composite_ctx_t ctx;
+    MC_DEFINE_SYSTEM(sys, fake_static_composite_sys_driver, ctx);
+
+    class StaticCompositeTest : public MeeCoreTest
+    {
+    protected:
+        void SetUp() override
+        {
+            MeeCoreTest::SetUp();
+            mc_sys_init(&sys);
+        }
+    };
+
+    TEST_F(StaticCompositeTest, InitResetsAllContexts)
+    {
+        ctx.sys1.x[0] = 5;
+        ctx.sys2.x[0] = 5;
+        mc_sys_init(&sys);
+
+        EXPECT_EQ(0, ctx.sys1.x[0]);
+        EXPECT_EQ(0, ctx.sys2.x[0]);
+    }
+
+    TEST_F(StaticCompositeTest, GetCountsAreSums)
+    {
+        EXPECT_EQ(2 * FAKE_SYS_F_COUNT, mc_sys_get_function_count(&sys));
+        EXPECT_EQ(2 * FAKE_SYS_X_COUNT, mc_sys_get_input_count(&sys));
+        EXPECT_EQ(2 * FAKE_SYS_Y_COUNT, mc_sys_get_output_count(&sys));
+        EXPECT_EQ(2 * FAKE_SYS_ALIAS_COUNT, mc_sys_get_alias_count(&sys));
+    }
+
+    TEST_F(StaticCompositeTest, WriteAndReadInputSucceeds)
+    {
+        EXPECT_EQ(MC_OK, mc_sys_write_input(&sys, 0, 3));
+        EXPECT_EQ(MC_OK, mc_sys_write_input(&sys, 3, 8));
+        EXPECT_EQ(3, ctx.sys1.x[0]);
+        EXPECT_EQ(8, ctx.sys2.x[1]);
+
+        mc_result_t res = mc_sys_read_input(&sys, 3);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(8, MC_RESULT_VALUE(res));
+    }
+
+    TEST_F(StaticCompositeTest, ReadOutputSucceeds)
+    {
+        ctx.sys1.y[0] = 5;
+        ctx.sys2.y[0] = 2;
+        mc_result_t res = mc_sys_read_output(&sys, 1);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(2, MC_RESULT_VALUE(res));
+    }
+
+    TEST_F(StaticCompositeTest, BatchOpsFallBackToSingleOps)
+    {
+        ctx.sys1.y[0] = 5;
+        ctx.sys2.y[0] = 2;
+        int32_t values[2];
+        EXPECT_EQ(MC_OK, mc_sys_read_outputs(&sys, 0, 2, values, NULL));
+        EXPECT_EQ(5, values[0]);
+        EXPECT_EQ(2, values[1]);
+
+        int32_t inputs[2] = {6, 7};
+        EXPECT_EQ(MC_OK, mc_sys_write_inputs(&sys, 1, 2, inputs, NULL));
+        EXPECT_EQ(6, ctx.sys1.x[1]);
+        EXPECT_EQ(7, ctx.sys2.x[0]);
+    }
+
+    TEST_F(StaticCompositeTest, InvokeSucceeds)
+    {
+        EXPECT_EQ(MC_OK, mc_sys_invoke(&sys, 2, NULL, 0));
+        EXPECT_EQ(0, ctx.sys1.y[0]);
+        EXPECT_EQ(1, ctx.sys2.y[0]);
+
+        int32_t args[1] = {MC_ERROR_BUSY};
+        EXPECT_EQ(MC_ERROR_BUSY, mc_sys_invoke(&sys, 3, args, 1));
+    }
+
+    TEST_F(StaticCompositeTest, GetAliasShiftsIds)
+    {
+        ctx.sys2.increment_y_name = "incrementY1";
+        ctx.sys2.x0_name = "input1";
+        ctx.sys2.y0_name = "output1";
+        mc_sys_cmd_info_t cmd;
+
+        EXPECT_EQ(MC_OK, mc_sys_get_alias(&sys, 4, &cmd));
+        EXPECT_STREQ("incrementY1", cmd.alias);
+        EXPECT_EQ(2, cmd.id); // Should be f2
+
+        EXPECT_EQ(MC_OK, mc_sys_get_alias(&sys, 5, &cmd));
+        EXPECT_STREQ("input1", cmd.alias);
+        EXPECT_EQ(2, cmd.id); // Should be x2
+
+        EXPECT_EQ(MC_OK, mc_sys_get_alias(&sys, 6, &cmd));
+        EXPECT_STREQ("output1", cmd.alias);
+        EXPECT_EQ(1, cmd.id); // Should be y1
+    }
+
+    TEST_F(StaticCompositeTest, UpdateNotSupportedWithoutUpdatingChildren)
+    {
+        EXPECT_FALSE(mc_sys_get_capabilities(&sys) & MC_SYS_CAP_UPDATE);
+        EXPECT_EQ(MC_ERROR_NOT_SUPPORTED, mc_sys_update(&sys, 10));
+    }
+
+    TEST_F(StaticCompositeTest, OutOfRangeIdsFail)
+    {
+        mc_sys_cmd_info_t cmd;
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS, mc_sys_write_input(&sys, 4, 1));
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS, mc_sys_invoke(&sys, 4, NULL, 0));
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS, mc_sys_get_alias(&sys, 8, &cmd));
+        EXPECT_FALSE(MC_RESULT_IS_OK(mc_sys_read_output(&sys, 2)));
+    }
+
+} // namespace
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "mc_test.h"
+
+extern "C"
+{
+#include "mc/system/core.h"
+#include "mc/system/subscription.h"
+#include "fakes/system/fake_system.h"
+}
+
+namespace
+{
+    // Globals
+    fake_sys_ctx_t ctx;
+    MC_DEFINE_SYSTEM(sys, fake_sys_driver, ctx);
+    MC_DEFINE_SYS_SUBSCRIPTION(sub, sys, 0, 10);
+    MC_DEFINE_SYS_SUBSCRIPTION(exact_sub, sys, 0, 0);
+
+    // Records the last change.
+    int change_count;
+    mc_sys_output_change_t last_change;
+    void on_change(void *cb_ctx, void *e)
+    {
+        (*(int *)cb_ctx)++;
+        last_change = *(mc_sys_output_change_t *)e;
+    }
+    MC_DEFINE_CALLBACK(cb, on_change, change_count);
+
+    class SubscriptionTest : public MeeCoreTest
+    {
+    protected:
+        void SetUp() override
+        {
+            MeeCoreTest::SetUp();
+            mc_sys_init(&sys);
+            mc_sys_subscribe(&sub);
+            mc_sys_subscription_register(&sub, &cb);
+            change_count = 0;
+        }
+
+        void TearDown() override
+        {
+            mc_sys_unsubscribe(&sub);
+        }
+    };
+
+    TEST_F(SubscriptionTest, FirstPollReportsValue)
+    {
+        ctx.y[0] = 42;
+        EXPECT_EQ(1, mc_sys_poll_subscriptions(&sys));
+        EXPECT_EQ(1, change_count);
+        EXPECT_EQ(&sys, last_change.system);
+        EXPECT_EQ(0, last_change.y_id);
+        EXPECT_EQ(42, last_change.value);
+        EXPECT_EQ(42, last_change.previous);
+
+        // Unchanged
+        EXPECT_EQ(0, mc_sys_poll_subscriptions(&sys));
+        EXPECT_EQ(1, change_count);
+    }
+
+    TEST_F(SubscriptionTest, ChangesWithinDeadbandAreIgnored)
+    {
+        ctx.y[0] = 100;
+        mc_sys_poll_subscriptions(&sys);
+
+        ctx.y[0] = 110;
+        EXPECT_EQ(0, mc_sys_poll_subscriptions(&sys));
+        ctx.y[0] = 90;
+        EXPECT_EQ(0, mc_sys_poll_subscriptions(&sys));
+
+        ctx.y[0] = 89;
+        EXPECT_EQ(1, mc_sys_poll_subscriptions(&sys));
+        EXPECT_EQ(89, last_change.value);
+        EXPECT_EQ(100, last_change.previous);
+    }
+
+    TEST_F(SubscriptionTest, SlowDriftIsReported)
+    {
+        ctx.y[0] = 0;
+        mc_sys_poll_subscriptions(&sys);
+
+        // Measured from the last reported value, not the last poll
+        for (int i = 1; i <= 11; i++)
+        {
+            ctx.y[0] = i;
+            mc_sys_poll_subscriptions(&sys);
+        }
+        EXPECT_EQ(2, change_count);
+        EXPECT_EQ(11, last_change.value);
+    }
+
+    TEST_F(SubscriptionTest, NotifyOutputFiresMatchingSubscriptions)
+    {
+        mc_sys_subscribe(&exact_sub);
+
+        EXPECT_EQ(2, mc_sys_notify_output(&sys, 0, 5));
+        EXPECT_EQ(1, mc_sys_notify_output(&sys, 0, 6));
+        EXPECT_EQ(0, mc_sys_notify_output(&sys, 1, 100));
+        EXPECT_EQ(1, change_count);
+
+        mc_sys_unsubscribe(&exact_sub);
+    }
+
+    TEST_F(SubscriptionTest, UnsubscribedIsNotPolled)
+    {
+        mc_sys_unsubscribe(&sub);
+        EXPECT_EQ(0, mc_sys_poll_subscriptions(&sys));
+        EXPECT_EQ(0, change_count);
+        mc_sys_subscribe(&sub);
+    }
+
+    TEST_F(SubscriptionTest, AssertDeathIfNull)
+    {
+        EXPECT_ANY_THROW(mc_sys_subscribe(NULL));
+        EXPECT_ANY_THROW(mc_sys_unsubscribe(NULL));
+        EXPECT_ANY_THROW(mc_sys_subscription_register(NULL, &cb));
+        EXPECT_ANY_THROW(mc_sys_subscription_unregister(NULL, &cb));
+        EXPECT_ANY_THROW(mc_sys_poll_subscriptions(NULL));
+        EXPECT_ANY_THROW(mc_sys_notify_output(NULL, 0, 0));
+    }
+}
@@ -51,20 +51,107 @@ namespace
         ctx.x[0] = 4;
         ctx.x[1] = 7;
         mc_result_t res = mc_sys_read_input(&sys, 0);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(4, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(4, MC_RESULT_VALUE(res));
 
         res = mc_sys_read_input(&sys, 1);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(7, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(7, MC_RESULT_VALUE(res));
     }
 
     TEST_F(SystemTest, ReadOutputSucceeds)
     {
         ctx.y[0] = 5;
         mc_result_t res = mc_sys_read_output(&sys, 0);
-        EXPECT_TRUE(res.ok);
-        EXPECT_EQ(5, res.value);
+        EXPECT_TRUE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(5, MC_RESULT_VALUE(res));
+    }
+
+    TEST_F(SystemTest, ReadOutputsReportsEachOutput)
+    {
+        ctx.y[0] = 5;
+        int32_t values[3] = {0};
+        mc_status_t errors[3];
+        mc_status_t ret = mc_sys_read_outputs(&sys, 0, 3, values, errors);
+
+        // Only y0 exists
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS, ret);
+        EXPECT_EQ(5, values[0]);
+        EXPECT_EQ(MC_OK, errors[0]);
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS, errors[1]);
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS, errors[2]);
+
+        EXPECT_EQ(MC_OK, mc_sys_read_outputs(&sys, 0, 1, values, NULL));
+    }
+
+    TEST_F(SystemTest, WriteInputsWritesRange)
+    {
+        int32_t values[2] = {3, 8};
+        mc_status_t ret = mc_sys_write_inputs(&sys, 0, 2, values, NULL);
+        EXPECT_EQ(MC_OK, ret);
+        EXPECT_EQ(3, ctx.x[0]);
+        EXPECT_EQ(8, ctx.x[1]);
+
+        mc_status_t errors[2];
+        ret = mc_sys_write_inputs(&sys, 1, 2, values, errors);
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS, ret);
+        EXPECT_EQ(3, ctx.x[1]);
+        EXPECT_EQ(MC_OK, errors[0]);
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS, errors[1]);
+    }
+
+    // Batch op that counts calls and fills outputs with their ID.
+    int batch_calls;
+    mc_status_t read_outputs_batch(void *ctx, mc_sys_id_t first_id,
+                                   mc_sys_id_t count, int32_t *values,
+                                   mc_status_t *errors)
+    {
+        (void)ctx;
+        (void)errors;
+        batch_calls++;
+        for (mc_sys_id_t i = 0; i < count; i++)
+        {
+            values[i] = first_id + i;
+        }
+        return MC_OK;
+    }
+
+    TEST_F(SystemTest, ReadOutputsUsesDriverBatchOp)
+    {
+        mc_system_driver_t batch_driver = fake_sys_driver;
+        batch_driver.read_outputs = read_outputs_batch;
+        mc_system_state_t state;
+        mc_system_t batch_sys = {
+            .driver = &batch_driver,
+            .ctx = &ctx,
+            .state = &state};
+        mc_sys_init(&batch_sys);
+        batch_calls = 0;
+
+        int32_t values[1] = {-1};
+        EXPECT_EQ(MC_OK, mc_sys_read_outputs(&batch_sys, 0, 1, values, NULL));
+        EXPECT_EQ(1, batch_calls);
+        EXPECT_EQ(0, values[0]);
+    }
+
+    TEST_F(SystemTest, CommitInputsWritesGivenIds)
+    {
+        mc_sys_id_t ids[2] = {1, 0};
+        int32_t values[2] = {7, 8};
+        mc_status_t errors[2];
+        EXPECT_EQ(MC_OK, mc_sys_commit_inputs(&sys, 2, ids, values, errors));
+        EXPECT_EQ(8, ctx.x[0]);
+        EXPECT_EQ(7, ctx.x[1]);
+        EXPECT_EQ(MC_OK, errors[0]);
+    }
+
+    TEST_F(SystemTest, CommitInputsRejectsWholeBatchOnInvalidId)
+    {
+        mc_sys_id_t ids[2] = {0, FAKE_SYS_X_COUNT};
+        int32_t values[2] = {7, 8};
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS,
+                  mc_sys_commit_inputs(&sys, 2, ids, values, NULL));
+        EXPECT_EQ(0, ctx.x[0]);
     }
 
     TEST_F(SystemTest, InvokeSucceeds)
@@ -105,12 +192,12 @@ namespace
         EXPECT_EQ(MC_ERROR_INVALID_ARGS, ret);
 
         mc_result_t res = mc_sys_read_input(&sys, 7);
-        EXPECT_FALSE(res.ok);
-        EXPECT_EQ(MC_ERROR_INVALID_ARGS, res.error);
+        EXPECT_FALSE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS, MC_RESULT_ERROR(res));
 
         res = mc_sys_read_output(&sys, 2);
-        EXPECT_FALSE(res.ok);
-        EXPECT_EQ(MC_ERROR_INVALID_ARGS, res.error);
+        EXPECT_FALSE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS, MC_RESULT_ERROR(res));
 
         ret = mc_sys_invoke(&sys, 7, NULL, 0);
         EXPECT_EQ(MC_ERROR_INVALID_ARGS, ret);
@@ -154,16 +241,16 @@ namespace
         ret = mc_sys_write_input(&null_sys, 0, 0);
         EXPECT_EQ(MC_ERROR_NOT_SUPPORTED, ret);
         mc_result_t res = mc_sys_read_input(&null_sys, 0);
-        EXPECT_FALSE(res.ok);
-        EXPECT_EQ(MC_ERROR_NOT_SUPPORTED, res.error);
+        EXPECT_FALSE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(MC_ERROR_NOT_SUPPORTED, MC_RESULT_ERROR(res));
         res = mc_sys_read_output(&null_sys, 0);
-        EXPECT_FALSE(res.ok);
-        EXPECT_EQ(MC_ERROR_NOT_SUPPORTED, res.error);
+        EXPECT_FALSE(MC_RESULT_IS_OK(res));
+        EXPECT_EQ(MC_ERROR_NOT_SUPPORTED, MC_RESULT_ERROR(res));
         mc_sys_cmd_info_t cmd;
         ret = mc_sys_get_alias(&null_sys, 0, &cmd);
         EXPECT_EQ(MC_ERROR_NOT_SUPPORTED, ret);
 
-        uint8_t val = mc_sys_get_function_count(&null_sys);
+        mc_sys_id_t val = mc_sys_get_function_count(&null_sys);
         EXPECT_EQ(0, val);
         val = mc_sys_get_input_count(&null_sys);
         EXPECT_EQ(0, val);
@@ -173,6 +260,128 @@ namespace
         EXPECT_EQ(0, val);
     }
 
+    TEST_F(SystemTest, CapabilitiesMatchDriver)
+    {
+        EXPECT_EQ(MC_SYS_CAP_INVOKE | MC_SYS_CAP_WRITE_INPUT |
+                      MC_SYS_CAP_READ_INPUT | MC_SYS_CAP_READ_OUTPUT |
+                      MC_SYS_CAP_GET_ALIAS,
+                  mc_sys_get_capabilities(&sys));
+    }
+
+    // Input count of the driver below, changed by tests.
+    mc_sys_id_t variable_input_count;
+    mc_sys_id_t get_variable_input_count(void *ctx)
+    {
+        (void)ctx;
+        return variable_input_count;
+    }
+
+    TEST_F(SystemTest, CountsAreCachedUntilInvalidated)
+    {
+        mc_system_driver_t variable_driver = fake_sys_driver;
+        variable_driver.get_input_count = get_variable_input_count;
+        mc_system_state_t state;
+        mc_system_t variable_sys = {
+            .driver = &variable_driver,
+            .ctx = &ctx,
+            .state = &state};
+        variable_input_count = 1;
+        mc_sys_init(&variable_sys);
+
+        variable_input_count = 2;
+        EXPECT_EQ(1, mc_sys_get_input_count(&variable_sys));
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS,
+                  mc_sys_write_input(&variable_sys, 1, 5));
+
+        mc_sys_invalidate(&variable_sys);
+        EXPECT_EQ(2, mc_sys_get_input_count(&variable_sys));
+        EXPECT_EQ(MC_OK, mc_sys_write_input(&variable_sys, 1, 5));
+
+        variable_input_count = 0;
+        mc_sys_invalidate_all();
+        EXPECT_EQ(0, mc_sys_get_input_count(&variable_sys));
+    }
+
+    TEST_F(SystemTest, InvalidateKeepsOtherSystemsCached)
+    {
+        mc_system_driver_t variable_driver = fake_sys_driver;
+        variable_driver.get_input_count = get_variable_input_count;
+        mc_system_state_t state_a;
+        mc_system_state_t state_b;
+        mc_system_t sys_a = {
+            .driver = &variable_driver, .ctx = &ctx, .state = &state_a};
+        mc_system_t sys_b = {
+            .driver = &variable_driver, .ctx = &ctx, .state = &state_b};
+        variable_input_count = 1;
+        mc_sys_init(&sys_a);
+        mc_sys_init(&sys_b);
+
+        variable_input_count = 2;
+        mc_sys_invalidate(&sys_a);
+        EXPECT_EQ(2, mc_sys_get_input_count(&sys_a));
+        EXPECT_EQ(1, mc_sys_get_input_count(&sys_b));
+    }
+
+    // Whether the counts_changed op below reports a change.
+    bool variable_counts_changed;
+    bool get_variable_counts_changed(void *ctx)
+    {
+        (void)ctx;
+        return variable_counts_changed;
+    }
+
+    TEST_F(SystemTest, CountsRefreshWhenDriverReportsChange)
+    {
+        mc_system_driver_t variable_driver = fake_sys_driver;
+        variable_driver.get_input_count = get_variable_input_count;
+        variable_driver.counts_changed = get_variable_counts_changed;
+        mc_system_state_t state;
+        mc_system_t variable_sys = {
+            .driver = &variable_driver,
+            .ctx = &ctx,
+            .state = &state};
+        variable_input_count = 1;
+        variable_counts_changed = false;
+        mc_sys_init(&variable_sys);
+
+        variable_input_count = 2;
+        EXPECT_EQ(1, mc_sys_get_input_count(&variable_sys));
+
+        variable_counts_changed = true;
+        EXPECT_EQ(2, mc_sys_get_input_count(&variable_sys));
+    }
+
+    // dt passed to the update op below.
+    uint32_t last_dt_ms;
+    mc_status_t update_records_dt(void *ctx, uint32_t dt_ms)
+    {
+        (void)ctx;
+        last_dt_ms = dt_ms;
+        return MC_OK;
+    }
+
+    TEST_F(SystemTest, UpdateCallsDriverOp)
+    {
+        mc_system_driver_t update_driver = fake_sys_driver;
+        update_driver.update = update_records_dt;
+        mc_system_state_t state;
+        mc_system_t update_sys = {
+            .driver = &update_driver,
+            .ctx = &ctx,
+            .state = &state};
+        mc_sys_init(&update_sys);
+
+        EXPECT_TRUE(mc_sys_get_capabilities(&update_sys) & MC_SYS_CAP_UPDATE);
+        EXPECT_EQ(MC_OK, mc_sys_update(&update_sys, 25));
+        EXPECT_EQ(25, last_dt_ms);
+    }
+
+    TEST_F(SystemTest, UpdateFailsWithoutDriverOp)
+    {
+        EXPECT_FALSE(mc_sys_get_capabilities(&sys) & MC_SYS_CAP_UPDATE);
+        EXPECT_EQ(MC_ERROR_NOT_SUPPORTED, mc_sys_update(&sys, 10));
+    }
+
     TEST_F(SystemTest, AssertDeathIfNullPointer)
     {
         int32_t args[1];
@@ -181,12 +390,20 @@ namespace
         EXPECT_ANY_THROW(mc_sys_write_input(NULL, 0, 1));
         EXPECT_ANY_THROW(mc_sys_read_input(NULL, 0));
         EXPECT_ANY_THROW(mc_sys_read_output(NULL, 0));
+        EXPECT_ANY_THROW(mc_sys_update(NULL, 1));
         EXPECT_ANY_THROW(mc_sys_get_alias(NULL, 0, &cmd));
         EXPECT_ANY_THROW(mc_sys_get_alias(&sys, 0, NULL));
         EXPECT_ANY_THROW(mc_sys_get_function_count(NULL));
         EXPECT_ANY_THROW(mc_sys_get_input_count(NULL));
         EXPECT_ANY_THROW(mc_sys_get_output_count(NULL));
         EXPECT_ANY_THROW(mc_sys_get_alias_count(NULL));
+        EXPECT_ANY_THROW(mc_sys_get_capabilities(NULL));
+        EXPECT_ANY_THROW(mc_sys_invalidate(NULL));
+        EXPECT_ANY_THROW(mc_sys_read_outputs(NULL, 0, 1, args, NULL));
+        EXPECT_ANY_THROW(mc_sys_read_outputs(&sys, 0, 1, NULL, NULL));
+        EXPECT_ANY_THROW(mc_sys_write_inputs(NULL, 0, 1, args, NULL));
+        EXPECT_ANY_THROW(mc_sys_write_inputs(&sys, 0, 1, NULL, NULL));
+        EXPECT_ANY_THROW(mc_sys_commit_inputs(NULL, 0, NULL, args, NULL));
     }
 
     TEST_F(SystemTest, AssertDeathIfUninitialized)
@@ -200,6 +417,7 @@ namespace
         EXPECT_ANY_THROW(mc_sys_write_input(&sys, 0, 1));
         EXPECT_ANY_THROW(mc_sys_read_input(&sys, 0));
         EXPECT_ANY_THROW(mc_sys_read_output(&sys, 0));
+        EXPECT_ANY_THROW(mc_sys_update(&sys, 1));
         EXPECT_ANY_THROW(mc_sys_get_alias(&sys, 0, &cmd));
         EXPECT_ANY_THROW(mc_sys_get_function_count(&sys));
         EXPECT_ANY_THROW(mc_sys_get_input_count(&sys));
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "mc_test.h"
+
+extern "C"
+{
+#include "mc/system/core.h"
+#include "mc/system/transaction.h"
+#include "fakes/system/fake_system.h"
+}
+
+namespace
+{
+
+    // Calls of the commit op below.
+    uint8_t commit_calls;
+    mc_sys_id_t last_commit_count;
+    mc_status_t commit_fake_inputs(void *ctx, mc_sys_id_t count,
+                                   const mc_sys_id_t *x_ids,
+                                   const int32_t *values, mc_status_t *errors)
+    {
+        fake_sys_ctx_t *fake_ctx = (fake_sys_ctx_t *)ctx;
+        commit_calls++;
+        last_commit_count = count;
+        for (mc_sys_id_t i = 0; i < count; i++)
+        {
+            fake_ctx->x[x_ids[i]] = values[i];
+        }
+        return MC_OK;
+    }
+
+    // Globals
+    fake_sys_ctx_t bus_ctx;
+    fake_sys_ctx_t plain_ctx;
+    mc_system_driver_t bus_driver;
+    MC_DEFINE_SYSTEM(bus_sys, bus_driver, bus_ctx);
+    MC_DEFINE_SYSTEM(plain_sys, fake_sys_driver, plain_ctx);
+    MC_DEFINE_SYS_TRANSACTION(txn, 3);
+
+    class TransactionTest : public MeeCoreTest
+    {
+    protected:
+        void SetUp() override
+        {
+            MeeCoreTest::SetUp();
+            bus_driver = fake_sys_driver;
+            bus_driver.commit_inputs = commit_fake_inputs;
+            mc_sys_init(&bus_sys);
+            mc_sys_init(&plain_sys);
+            commit_calls = 0;
+            mc_sys_txn_begin(&txn);
+        }
+    };
+
+    TEST_F(TransactionTest, WritesAreStagedUntilCommit)
+    {
+        EXPECT_EQ(MC_OK, mc_sys_txn_write(&txn, &plain_sys, 0, 5));
+        EXPECT_EQ(MC_OK, mc_sys_txn_write(&txn, &plain_sys, 1, 6));
+        EXPECT_EQ(2, mc_sys_txn_get_count(&txn));
+        EXPECT_EQ(0, plain_ctx.x[0]);
+
+        EXPECT_EQ(MC_OK, mc_sys_txn_commit(&txn));
+        EXPECT_EQ(5, plain_ctx.x[0]);
+        EXPECT_EQ(6, plain_ctx.x[1]);
+        EXPECT_EQ(0, mc_sys_txn_get_count(&txn));
+    }
+
+    TEST_F(TransactionTest, CommitUsesOneDriverCallPerSystem)
+    {
+        // Interleaved staging still ends up in one batch
+        mc_sys_txn_write(&txn, &bus_sys, 0, 1);
+        mc_sys_txn_write(&txn, &plain_sys, 0, 2);
+        mc_sys_txn_write(&txn, &bus_sys, 1, 3);
+
+        EXPECT_EQ(MC_OK, mc_sys_txn_commit(&txn));
+        EXPECT_EQ(1, commit_calls);
+        EXPECT_EQ(2, last_commit_count);
+        EXPECT_EQ(1, bus_ctx.x[0]);
+        EXPECT_EQ(3, bus_ctx.x[1]);
+        EXPECT_EQ(2, plain_ctx.x[0]);
+    }
+
+    TEST_F(TransactionTest, RestagingReplacesValue)
+    {
+        mc_sys_txn_write(&txn, &plain_sys, 0, 1);
+        mc_sys_txn_write(&txn, &plain_sys, 0, 9);
+        EXPECT_EQ(1, mc_sys_txn_get_count(&txn));
+
+        mc_sys_txn_commit(&txn);
+        EXPECT_EQ(9, plain_ctx.x[0]);
+    }
+
+    TEST_F(TransactionTest, WriteFailsWhenFull)
+    {
+        mc_sys_txn_write(&txn, &plain_sys, 0, 1);
+        mc_sys_txn_write(&txn, &plain_sys, 1, 1);
+        mc_sys_txn_write(&txn, &bus_sys, 0, 1);
+        EXPECT_EQ(MC_ERROR_NO_RESOURCE, mc_sys_txn_write(&txn, &bus_sys, 1, 1));
+
+        // Replacing still works
+        EXPECT_EQ(MC_OK, mc_sys_txn_write(&txn, &bus_sys, 0, 2));
+    }
+
+    TEST_F(TransactionTest, WriteFailsWithInvalidId)
+    {
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS,
+                  mc_sys_txn_write(&txn, &plain_sys, FAKE_SYS_X_COUNT, 1));
+        EXPECT_EQ(0, mc_sys_txn_get_count(&txn));
+    }
+
+    TEST_F(TransactionTest, AbortDiscardsWrites)
+    {
+        mc_sys_txn_write(&txn, &plain_sys, 0, 5);
+        mc_sys_txn_abort(&txn);
+        EXPECT_EQ(0, mc_sys_txn_get_count(&txn));
+
+        EXPECT_EQ(MC_OK, mc_sys_txn_commit(&txn));
+        EXPECT_EQ(0, plain_ctx.x[0]);
+    }
+
+    TEST_F(TransactionTest, AssertDeathIfNull)
+    {
+        EXPECT_ANY_THROW(mc_sys_txn_begin(NULL));
+        EXPECT_ANY_THROW(mc_sys_txn_write(NULL, &plain_sys, 0, 1));
+        EXPECT_ANY_THROW(mc_sys_txn_write(&txn, NULL, 0, 1));
+        EXPECT_ANY_THROW(mc_sys_txn_get_count(NULL));
+        EXPECT_ANY_THROW(mc_sys_txn_commit(NULL));
+        EXPECT_ANY_THROW(mc_sys_txn_abort(NULL));
+    }
+
+} // namespace
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "mc_test.h"
+
+extern "C"
+{
+#include "mc/arena.h"
+}
+
+namespace
+{
+    // Globals. 60 bytes get rounded up to 64.
+    MC_DEFINE_ARENA(arena, 60);
+
+    class ArenaTest : public MeeCoreTest
+    {
+    protected:
+        void SetUp() override
+        {
+            MeeCoreTest::SetUp();
+            mc_arena_init(&arena);
+        }
+    };
+
+    TEST_F(ArenaTest, AllocReturnsAlignedConsecutiveMemory)
+    {
+        uint8_t *a = (uint8_t *)mc_arena_alloc(&arena, 3);
+        uint8_t *b = (uint8_t *)mc_arena_alloc(&arena, 10);
+        uint8_t *c = (uint8_t *)mc_arena_alloc(&arena, 8);
+        EXPECT_EQ(arena.buffer, a);
+        EXPECT_EQ(a + 8, b);
+        EXPECT_EQ(b + 16, c);
+        EXPECT_EQ(0, (uintptr_t)c % MC_ARENA_ALIGN);
+    }
+
+    TEST_F(ArenaTest, AllocReturnsNullIfFull)
+    {
+        EXPECT_EQ(64, arena.size);
+        EXPECT_TRUE(mc_arena_alloc(&arena, 64) != NULL);
+        EXPECT_TRUE(mc_arena_alloc(&arena, 1) == NULL);
+
+        mc_arena_stats_t stats;
+        mc_arena_get_stats(&arena, &stats);
+        EXPECT_EQ(1, stats.failure_count);
+    }
+
+    TEST_F(ArenaTest, ResetToMarkFreesNewerAllocations)
+    {
+        mc_arena_alloc(&arena, 8);
+        mc_arena_mark_t mark = mc_arena_mark(&arena);
+        uint8_t *scratch = (uint8_t *)mc_arena_alloc(&arena, 16);
+        mc_arena_alloc(&arena, 16);
+
+        mc_arena_reset_to(&arena, mark);
+        EXPECT_EQ(8, mc_arena_mark(&arena));
+
+        // Memory after the mark gets handed out again.
+        EXPECT_EQ(scratch, mc_arena_alloc(&arena, 4));
+    }
+
+    TEST_F(ArenaTest, ResetKeepsHighWater)
+    {
+        mc_arena_alloc(&arena, 20);
+        mc_arena_alloc(&arena, 20);
+        mc_arena_reset(&arena);
+        mc_arena_alloc(&arena, 8);
+
+        mc_arena_stats_t stats;
+        mc_arena_get_stats(&arena, &stats);
+        EXPECT_EQ(64, stats.size);
+        EXPECT_EQ(8, stats.used);
+        EXPECT_EQ(48, stats.high_water);
+        EXPECT_EQ(0, stats.failure_count);
+    }
+
+    TEST_F(ArenaTest, AssertDeathIfMarkIsNewer)
+    {
+        mc_arena_alloc(&arena, 16);
+        mc_arena_mark_t mark = mc_arena_mark(&arena);
+        mc_arena_reset(&arena);
+        EXPECT_ANY_THROW(mc_arena_reset_to(&arena, mark));
+    }
+
+    TEST_F(ArenaTest, AssertDeathIfNull)
+    {
+        mc_arena_stats_t stats;
+        EXPECT_ANY_THROW(mc_arena_init(NULL));
+        EXPECT_ANY_THROW(mc_arena_alloc(NULL, 1));
+        EXPECT_ANY_THROW(mc_arena_mark(NULL));
+        EXPECT_ANY_THROW(mc_arena_reset_to(NULL, 0));
+        EXPECT_ANY_THROW(mc_arena_reset(NULL));
+        EXPECT_ANY_THROW(mc_arena_get_stats(NULL, &stats));
+        EXPECT_ANY_THROW(mc_arena_get_stats(&arena, NULL));
+    }
+}
@@ -14,6 +14,17 @@ extern "C"
 namespace
 {
 
+    // Last assert reported to record_assert
+    std::string assert_file;
+    int assert_line;
+
+    extern "C" void record_assert(const char *expr, const char *file, int line)
+    {
+        (void)expr;
+        assert_file = file;
+        assert_line = line;
+    }
+
     // Globals
     fake_stream_ctx_t ctx;
     fake_time_ctx_t time_ctx;
@@ -84,4 +95,15 @@ namespace
         EXPECT_EQ(0, strlen(ctx.output_data));
     }
 
+    TEST_F(DebugTest, CompactAssertReportsFileId)
+    {
+        mc_assert_set_override(record_assert);
+        mc_assert_handler_compact(MC_FILE_ID_SYS_CONSOLE, 42);
+        EXPECT_EQ("#15", assert_file);
+        EXPECT_EQ(42, assert_line);
+
+        mc_assert_handler_compact(UINT16_MAX, 7);
+        EXPECT_EQ("#65535", assert_file);
+    }
+
 }
\ No newline at end of file
@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 #include "mc_test.h"
 #include "mc/event.h"
+extern "C"
+{
+#include "mc/time.h"
+#include "fakes/fake_time.h"
+}
 
 namespace
 {
@@ -29,6 +34,49 @@ namespace
         mc_event_unregister(data->event, data->callback);
     }
 
+    // Test callback. Post the event again from within the listener.
+    void add_to_num_and_post(void *context, void *arg)
+    {
+        add_to_num(context, arg);
+        my_event_data_t *data = (my_event_data_t *)context;
+        mc_event_post(data->event, arg);
+    }
+
+    // Test filter. Adds like add_to_num, but consumes the event if the
+    // increment is negative.
+    mc_event_action_t add_to_num_or_stop(void *context, void *arg)
+    {
+        add_to_num(context, arg);
+        return *(int *)arg < 0 ? MC_EVENT_STOP : MC_EVENT_CONTINUE;
+    }
+
+    // Test callback. Record the order in which callbacks ran.
+    static int call_order[4];
+    static int call_count;
+    void record_order(void *context, void *arg)
+    {
+        call_order[call_count++] = *(int *)context;
+    }
+
+    // Static handlers. They get no ctx, so they bump a global.
+    static int static_total;
+    void add_to_static_total(void *context, void *arg)
+    {
+        static_total += *(int *)arg;
+    }
+    void double_static_total(void *context, void *arg)
+    {
+        static_total *= 2;
+    }
+
+#if MC_EVENT_PROFILING
+    // Test callback. Takes as many ms as the event data says.
+    void delay_ms(void *context, void *arg)
+    {
+        mc_time_delay(*(uint32_t *)arg);
+    }
+#endif
+
     // Globals
     static my_event_data_t data1;
     static my_event_data_t data2;
@@ -38,6 +86,22 @@ namespace
     // Only cb2 unregisters itself
     MC_DEFINE_CALLBACK(cb2, add_to_num_and_unregister, data2);
     MC_DEFINE_CALLBACK(cb3, add_to_num, data3);
+    MC_DEFINE_CALLBACK(cb_post, add_to_num_and_post, data1);
+    MC_DEFINE_EVENT_QUEUE(queue, 3);
+    static int id_low = 1;
+    static int id_default = 2;
+    static int id_high = 3;
+    MC_DEFINE_CALLBACK_WITH_PRIORITY(cb_low, record_order, id_low, -5);
+    MC_DEFINE_CALLBACK_WITH_PRIORITY(cb_default, record_order, id_default,
+                                     MC_EVENT_PRIORITY_DEFAULT);
+    MC_DEFINE_CALLBACK_WITH_PRIORITY(cb_high, record_order, id_high, 10);
+    MC_DEFINE_FILTER(filter, add_to_num_or_stop, data2, 5);
+#if MC_EVENT_PROFILING
+    MC_DEFINE_CALLBACK(cb_delay, delay_ms, data1);
+    fake_time_ctx_t time_ctx;
+#endif
+    MC_DEFINE_STATIC_EVENT(static_event, add_to_static_total,
+                           double_static_total);
 
     class EventTest : public MeeCoreTest
     {
@@ -46,9 +110,13 @@ namespace
         {
             MeeCoreTest::SetUp();
             mc_event_init(&event);
+            mc_event_queue_init(&queue);
             InitializeData(data1, cb1);
             InitializeData(data2, cb2);
             InitializeData(data3, cb3);
+            call_count = 0;
+            static_total = 0;
+            mc_event_init(static_event.dynamic);
         }
 
     private:
@@ -77,6 +145,60 @@ namespace
         mc_callback_init(&cb, add_to_num, &data1);
         EXPECT_EQ(cb.ctx, &data1);
         EXPECT_EQ(cb.func, add_to_num);
+        EXPECT_EQ(cb.filter, nullptr);
+        EXPECT_EQ(cb.priority, MC_EVENT_PRIORITY_DEFAULT);
+
+        mc_filter_init(&cb, add_to_num_or_stop, &data2, 3);
+        EXPECT_EQ(cb.ctx, &data2);
+        EXPECT_EQ(cb.func, nullptr);
+        EXPECT_EQ(cb.filter, add_to_num_or_stop);
+        EXPECT_EQ(cb.priority, 3);
+    }
+
+    TEST_F(EventTest, RegisterSortsByPriority)
+    {
+        int unused = 0;
+        mc_event_register(&event, &cb_default);
+        mc_event_register(&event, &cb_low);
+        mc_event_register(&event, &cb_high);
+
+        mc_event_trigger(&event, &unused);
+        ASSERT_EQ(3, call_count);
+        EXPECT_EQ(id_high, call_order[0]);
+        EXPECT_EQ(id_default, call_order[1]);
+        EXPECT_EQ(id_low, call_order[2]);
+    }
+
+    TEST_F(EventTest, SamePriorityKeepsRegistrationOrder)
+    {
+        int unused = 0;
+        mc_callback_t cb_other;
+        mc_callback_init(&cb_other, record_order, &id_low);
+        mc_event_register(&event, &cb_default);
+        mc_event_register(&event, &cb_other);
+
+        mc_event_trigger(&event, &unused);
+        ASSERT_EQ(2, call_count);
+        EXPECT_EQ(id_default, call_order[0]);
+        EXPECT_EQ(id_low, call_order[1]);
+    }
+
+    TEST_F(EventTest, FilterStopsPropagation)
+    {
+        // filter has priority 5, so it runs before cb1 (default priority).
+        mc_event_register(&event, &cb1);
+        mc_event_register(&event, &filter);
+
+        int increment = 4;
+        mc_event_trigger(&event, &increment);
+        EXPECT_EQ(4, data2.num);
+        EXPECT_EQ(4, data1.num);
+
+        // Negative increment is consumed by the filter.
+        increment = -1;
+        mc_event_trigger(&event, &increment);
+        EXPECT_EQ(3, data2.num);
+        EXPECT_EQ(4, data1.num);
     }
 
     TEST_F(EventTest, TriggerInvokesCallbacks)
@@ -114,15 +236,178 @@ namespace
         EXPECT_EQ(4, data2.num);
     }
 
+    TEST_F(EventTest, StaticEventCallsHandlersInOrder)
+    {
+        int increment = 3;
+        EXPECT_EQ(2, static_event.count);
+
+        // (0 + 3) * 2
+        mc_static_event_trigger(&static_event, &increment);
+        EXPECT_EQ(6, static_total);
+    }
+
+    TEST_F(EventTest, StaticEventCallsDynamicListeners)
+    {
+        int increment = 3;
+        mc_static_event_register(&static_event, &cb1);
+        mc_static_event_trigger(&static_event, &increment);
+        EXPECT_EQ(6, static_total);
+        EXPECT_EQ(3, data1.num);
+
+        mc_static_event_unregister(&static_event, &cb1);
+        mc_static_event_trigger(&static_event, &increment);
+        EXPECT_EQ(18, static_total);
+        EXPECT_EQ(3, data1.num);
+    }
+
+    TEST_F(EventTest, PostDefersTriggerUntilDispatch)
+    {
+        int increment = 4;
+        mc_event_register(&event, &cb1);
+        EXPECT_EQ(MC_OK, mc_event_post(&event, &increment));
+        EXPECT_EQ(MC_OK, mc_event_post(&event, &increment));
+
+        // Nothing should run until dispatch.
+        EXPECT_EQ(0, data1.num);
+        EXPECT_EQ(2, mc_event_get_pending_count());
+
+        EXPECT_EQ(2, mc_event_dispatch_pending());
+        EXPECT_EQ(8, data1.num);
+        EXPECT_EQ(0, mc_event_get_pending_count());
+
+        // Nothing left to dispatch.
+        EXPECT_EQ(0, mc_event_dispatch_pending());
+        EXPECT_EQ(8, data1.num);
+    }
+
+    TEST_F(EventTest, PostFailsIfQueueIsFull)
+    {
+        int increment = 1;
+        mc_event_register(&event, &cb1);
+        EXPECT_EQ(MC_OK, mc_event_post(&event, &increment));
+        EXPECT_EQ(MC_OK, mc_event_post(&event, &increment));
+        EXPECT_EQ(MC_OK, mc_event_post(&event, &increment));
+        EXPECT_EQ(MC_ERROR_NO_RESOURCE, mc_event_post(&event, &increment));
+        EXPECT_EQ(1, mc_event_get_dropped_count());
+
+        // Queue wraps around after dispatch.
+        EXPECT_EQ(3, mc_event_dispatch_pending());
+        EXPECT_EQ(MC_OK, mc_event_post(&event, &increment));
+        EXPECT_EQ(1, mc_event_dispatch_pending());
+        EXPECT_EQ(4, data1.num);
+    }
+
+    TEST_F(EventTest, QueueKeepsOrderPastCounterRange)
+    {
+        int increments[2] = {1, 1000};
+        mc_event_register(&event, &cb1);
+
+        // More posts than a uint16_t counter holds, with capacity 3 which
+        // does not divide 65536.
+        for (int i = 0; i < 40000; i++)
+        {
+            ASSERT_EQ(MC_OK, mc_event_post(&event, &increments[0]));
+            ASSERT_EQ(MC_OK, mc_event_post(&event, &increments[1]));
+            ASSERT_EQ(2, mc_event_get_pending_count());
+
+            // A lost or repeated entry changes the sum.
+            data1.num = 0;
+            ASSERT_EQ(MC_OK, mc_event_post(&event, &increments[0]));
+            ASSERT_EQ(3, mc_event_dispatch_pending());
+            ASSERT_EQ(1002, data1.num);
+            ASSERT_EQ(0, mc_event_get_pending_count());
+        }
+    }
+
+    TEST_F(EventTest, CoalescedPostTriggersOnceWithLatestData)
+    {
+        int first = 4;
+        int second = 7;
+        mc_event_register(&event, &cb1);
+        EXPECT_EQ(MC_OK, mc_event_post_coalesced(&event, &first));
+        EXPECT_EQ(MC_OK, mc_event_post_coalesced(&event, &second));
+        EXPECT_EQ(1, mc_event_get_pending_count());
+
+        EXPECT_EQ(1, mc_event_dispatch_pending());
+        EXPECT_EQ(7, data1.num);
+
+        // Event can be posted again once dispatched.
+        EXPECT_EQ(MC_OK, mc_event_post_coalesced(&event, &first));
+        EXPECT_EQ(1, mc_event_dispatch_pending());
+        EXPECT_EQ(11, data1.num);
+    }
+
+    TEST_F(EventTest, DispatchDefersEventsPostedByListeners)
+    {
+        int increment = 4;
+        mc_event_register(&event, &cb_post);
+        mc_event_post(&event, &increment);
+
+        // Listener posts again, but that runs on the next dispatch.
+        EXPECT_EQ(1, mc_event_dispatch_pending());
+        EXPECT_EQ(4, data1.num);
+        EXPECT_EQ(1, mc_event_get_pending_count());
+
+        mc_event_unregister(&event, &cb_post);
+        EXPECT_EQ(1, mc_event_dispatch_pending());
+        EXPECT_EQ(4, data1.num);
+    }
+
+#if MC_EVENT_PROFILING
+    TEST_F(EventTest, ProfilingRecordsTriggerCountAndTiming)
+    {
+        mc_time_init(&fake_time_driver, &time_ctx);
+        mc_callback_init(&cb_delay, delay_ms, &data1);
+        mc_event_register(&event, &cb_delay);
+
+        uint32_t delay = 2;
+        mc_event_trigger(&event, &delay);
+        delay = 6;
+        mc_event_trigger(&event, &delay);
+        delay = 4;
+        mc_event_trigger(&event, &delay);
+
+        EXPECT_EQ(3, mc_event_get_trigger_count(&event));
+        EXPECT_EQ(3, cb_delay.stats.call_count);
+        EXPECT_EQ(2000, cb_delay.stats.min_us);
+        EXPECT_EQ(6000, cb_delay.stats.max_us);
+        EXPECT_EQ(4000, mc_callback_get_avg_us(&cb_delay));
+
+        mc_event_profile_reset(&event);
+        EXPECT_EQ(0, mc_event_get_trigger_count(&event));
+        EXPECT_EQ(0, cb_delay.stats.call_count);
+        EXPECT_EQ(0, mc_callback_get_avg_us(&cb_delay));
+    }
+
+    TEST_F(EventTest, ProfileRegisterAddsEventToList)
+    {
+        MC_DEFINE_EVENT(profiled);
+        mc_event_profile_register(&profiled, "profiled");
+
+        mc_node_t *tail = mc_list_peek_tail(mc_event_profile_get_events());
+        EXPECT_EQ(&profiled.profile_node, tail);
+        EXPECT_STREQ("profiled", profiled.name);
+        mc_list_remove(mc_event_profile_get_events(), tail);
+    }
+#endif
+
     TEST_F(EventTest, AssertDeathIfNull)
     {
         int increment = 4;
         EXPECT_ANY_THROW(mc_event_init(NULL));
         EXPECT_ANY_THROW(mc_callback_init(NULL, add_to_num, &data1));
+        EXPECT_ANY_THROW(mc_filter_init(NULL, add_to_num_or_stop, &data1, 0));
+        EXPECT_ANY_THROW(mc_callback_set_priority(NULL, 0));
         EXPECT_ANY_THROW(mc_event_register(NULL, &cb1));
         EXPECT_ANY_THROW(mc_event_register(&event, NULL));
         EXPECT_ANY_THROW(mc_event_unregister(NULL, &cb1));
         EXPECT_ANY_THROW(mc_event_unregister(&event, NULL));
         EXPECT_ANY_THROW(mc_event_trigger(NULL, &increment));
+        EXPECT_ANY_THROW(mc_static_event_trigger(NULL, &increment));
+        EXPECT_ANY_THROW(mc_static_event_register(NULL, &cb1));
+        EXPECT_ANY_THROW(mc_static_event_register(&static_event, NULL));
+        EXPECT_ANY_THROW(mc_event_queue_init(NULL));
+        EXPECT_ANY_THROW(mc_event_post(NULL, &increment));
+        EXPECT_ANY_THROW(mc_event_post_coalesced(NULL, &increment));
     }
 }
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "mc_test.h"
+
+extern "C"
+{
+#include "mc/latest_event.h"
+#include "mc/utils.h"
+}
+
+namespace
+{
+    // Listener data. Records how often it ran and the last value it got.
+    typedef struct
+    {
+        int call_count;
+        mc_vector3_t last;
+    } listener_data_t;
+
+    // Test callback. Copy the value out.
+    void record_value(void *context, void *arg)
+    {
+        listener_data_t *data = (listener_data_t *)context;
+        data->call_count++;
+        data->last = *(mc_vector3_t *)arg;
+    }
+
+    // Globals
+    static listener_data_t data;
+    MC_DEFINE_LATEST_EVENT(accel, mc_vector3_t);
+    MC_DEFINE_CALLBACK(cb, record_value, data);
+
+    class LatestEventTest : public MeeCoreTest
+    {
+    protected:
+        void SetUp() override
+        {
+            MeeCoreTest::SetUp();
+            mc_latest_event_init(&accel);
+            mc_latest_event_register(&accel, &cb);
+            data = {0};
+        }
+    };
+
+    TEST_F(LatestEventTest, DispatchWithoutPublishDoesNothing)
+    {
+        EXPECT_FALSE(mc_latest_event_dispatch(&accel));
+        EXPECT_EQ(0, data.call_count);
+    }
+
+    TEST_F(LatestEventTest, DispatchDeliversPublishedValue)
+    {
+        mc_vector3_t value = {.x = 1, .y = 2, .z = 3};
+        mc_latest_event_publish(&accel, &value);
+
+        // Nothing happens until dispatch.
+        EXPECT_EQ(0, data.call_count);
+
+        EXPECT_TRUE(mc_latest_event_dispatch(&accel));
+        EXPECT_EQ(1, data.call_count);
+        EXPECT_EQ(1, data.last.x);
+        EXPECT_EQ(2, data.last.y);
+        EXPECT_EQ(3, data.last.z);
+
+        // Value is no longer dirty.
+        EXPECT_FALSE(mc_latest_event_dispatch(&accel));
+        EXPECT_EQ(1, data.call_count);
+    }
+
+    TEST_F(LatestEventTest, DispatchDeliversNewestValueOnce)
+    {
+        mc_vector3_t value = {.x = 1, .y = 1, .z = 1};
+        mc_latest_event_publish(&accel, &value);
+        value.x = 2;
+        mc_latest_event_publish(&accel, &value);
+        value.x = 3;
+        mc_latest_event_publish(&accel, &value);
+
+        EXPECT_TRUE(mc_latest_event_dispatch(&accel));
+        EXPECT_EQ(1, data.call_count);
+        EXPECT_EQ(3, data.last.x);
+        EXPECT_EQ(2, mc_latest_event_get_superseded_count(&accel));
+    }
+
+    TEST_F(LatestEventTest, UnregisterStopsDelivery)
+    {
+        mc_vector3_t value = {.x = 1, .y = 1, .z = 1};
+        mc_latest_event_unregister(&accel, &cb);
+        mc_latest_event_publish(&accel, &value);
+
+        EXPECT_TRUE(mc_latest_event_dispatch(&accel));
+        EXPECT_EQ(0, data.call_count);
+    }
+
+    TEST_F(LatestEventTest, AssertDeathIfNull)
+    {
+        mc_vector3_t value = {0};
+        EXPECT_ANY_THROW(mc_latest_event_init(NULL));
+        EXPECT_ANY_THROW(mc_latest_event_publish(NULL, &value));
+        EXPECT_ANY_THROW(mc_latest_event_publish(&accel, NULL));
+        EXPECT_ANY_THROW(mc_latest_event_dispatch(NULL));
+        EXPECT_ANY_THROW(mc_latest_event_register(NULL, &cb));
+        EXPECT_ANY_THROW(mc_latest_event_register(&accel, NULL));
+        EXPECT_ANY_THROW(mc_latest_event_unregister(NULL, &cb));
+        EXPECT_ANY_THROW(mc_latest_event_get_superseded_count(NULL));
+    }
+}
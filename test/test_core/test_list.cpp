@@ -89,6 +89,27 @@ namespace
         EXPECT_EQ(&item2.node, item1.node.prev); // 1 <- 2
     }
 
+    TEST_F(ListTest, InsertBeforeLinksNode)
+    {
+        // NULL position appends
+        mc_list_insert_before(&list, NULL, &item3.node); // List: [3]
+        EXPECT_EQ(&item3.node, mc_list_peek_tail(&list));
+
+        // Before head prepends
+        mc_list_insert_before(&list, &item3.node, &item1.node); // List: [1, 3]
+        EXPECT_EQ(&item1.node, mc_list_peek_head(&list));
+
+        // Middle insert
+        mc_list_insert_before(&list, &item3.node, &item2.node); // List: [1, 2, 3]
+        EXPECT_EQ(3, mc_list_count(&list));
+
+        // Verify Links
+        EXPECT_EQ(&item2.node, item1.node.next); // 1 -> 2
+        EXPECT_EQ(&item3.node, item2.node.next); // 2 -> 3
+        EXPECT_EQ(&item1.node, item2.node.prev); // 2 <- 1
+        EXPECT_EQ(&item2.node, item3.node.prev); // 3 <- 2
+    }
+
     TEST_F(ListTest, RemoveHandleSucceeds)
     {
         mc_list_append(&list, &item1.node);
@@ -312,6 +333,15 @@ namespace
         EXPECT_EQ(nullptr, mc_list_prev(curr));
     }
 
+#if MC_ASSERT_LEVEL >= MC_ASSERT_LEVEL_PARANOID
+    TEST_F(ListTest, InsertBeforeAssertDeathIfPositionNotInList)
+    {
+        mc_list_append(&list, &item1.node);
+        EXPECT_ANY_THROW(
+            mc_list_insert_before(&list, &item2.node, &item3.node));
+    }
+#endif
+
     TEST_F(ListTest, AppendAssertDeathIfListIsNull)
     {
         EXPECT_ANY_THROW(mc_list_init(NULL));
@@ -319,6 +349,8 @@ namespace
         EXPECT_ANY_THROW(mc_list_append(&list, NULL));
         EXPECT_ANY_THROW(mc_list_prepend(NULL, &item1.node));
         EXPECT_ANY_THROW(mc_list_prepend(&list, NULL));
+        EXPECT_ANY_THROW(mc_list_insert_before(NULL, NULL, &item1.node));
+        EXPECT_ANY_THROW(mc_list_insert_before(&list, NULL, NULL));
         EXPECT_ANY_THROW(mc_list_remove(NULL, &item1.node));
         EXPECT_ANY_THROW(mc_list_remove(&list, NULL));
         EXPECT_ANY_THROW(mc_list_peek_head(NULL));
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "mc_test.h"
+
+extern "C"
+{
+#include "mc/pool.h"
+}
+
+namespace
+{
+    // Globals. 5 byte blocks get rounded up, 40 blocks span two bitmap words.
+    MC_DEFINE_POOL(pool, 5, 40);
+
+    class PoolTest : public MeeCoreTest
+    {
+    protected:
+        void SetUp() override
+        {
+            MeeCoreTest::SetUp();
+            mc_pool_init(&pool);
+        }
+    };
+
+    TEST_F(PoolTest, BlockSizeIsAligned)
+    {
+        EXPECT_EQ(MC_POOL_ALIGN, pool.block_size);
+        EXPECT_EQ(0, (uintptr_t)mc_pool_alloc(&pool) % MC_POOL_ALIGN);
+    }
+
+    TEST_F(PoolTest, AllocReturnsDistinctBlocks)
+    {
+        uint8_t *a = (uint8_t *)mc_pool_alloc(&pool);
+        uint8_t *b = (uint8_t *)mc_pool_alloc(&pool);
+        EXPECT_TRUE(a != NULL);
+        EXPECT_TRUE(b != NULL);
+        EXPECT_EQ(pool.block_size, b - a);
+    }
+
+    TEST_F(PoolTest, AllocReturnsNullIfExhausted)
+    {
+        for (int i = 0; i < 40; i++)
+        {
+            EXPECT_TRUE(mc_pool_alloc(&pool) != NULL);
+        }
+        EXPECT_TRUE(mc_pool_alloc(&pool) == NULL);
+
+        mc_pool_stats_t stats;
+        mc_pool_get_stats(&pool, &stats);
+        EXPECT_EQ(40, stats.used_count);
+        EXPECT_EQ(1, stats.failure_count);
+    }
+
+    TEST_F(PoolTest, FreeMakesBlockAvailableAgain)
+    {
+        void *blocks[40];
+        for (int i = 0; i < 40; i++)
+        {
+            blocks[i] = mc_pool_alloc(&pool);
+        }
+
+        // Free a block from the second bitmap word.
+        mc_pool_free(&pool, blocks[35]);
+        EXPECT_EQ(blocks[35], mc_pool_alloc(&pool));
+    }
+
+    TEST_F(PoolTest, StatsTrackHighWater)
+    {
+        void *a = mc_pool_alloc(&pool);
+        void *b = mc_pool_alloc(&pool);
+        void *c = mc_pool_alloc(&pool);
+        mc_pool_free(&pool, a);
+        mc_pool_free(&pool, b);
+
+        mc_pool_stats_t stats;
+        mc_pool_get_stats(&pool, &stats);
+        EXPECT_EQ(MC_POOL_ALIGN, stats.block_size);
+        EXPECT_EQ(40, stats.block_count);
+        EXPECT_EQ(1, stats.used_count);
+        EXPECT_EQ(3, stats.high_water);
+        EXPECT_EQ(0, stats.failure_count);
+        mc_pool_free(&pool, c);
+    }
+
+    TEST_F(PoolTest, AssertDeathIfFreeIsInvalid)
+    {
+        uint8_t *a = (uint8_t *)mc_pool_alloc(&pool);
+        int32_t other = 0;
+
+        // Not from this pool, not at block start, double free.
+        EXPECT_ANY_THROW(mc_pool_free(&pool, &other));
+        EXPECT_ANY_THROW(mc_pool_free(&pool, a + 1));
+        mc_pool_free(&pool, a);
+        EXPECT_ANY_THROW(mc_pool_free(&pool, a));
+    }
+
+    TEST_F(PoolTest, AssertDeathIfNull)
+    {
+        mc_pool_stats_t stats;
+        EXPECT_ANY_THROW(mc_pool_init(NULL));
+        EXPECT_ANY_THROW(mc_pool_alloc(NULL));
+        EXPECT_ANY_THROW(mc_pool_free(NULL, pool.storage));
+        EXPECT_ANY_THROW(mc_pool_free(&pool, NULL));
+        EXPECT_ANY_THROW(mc_pool_get_stats(NULL, &stats));
+        EXPECT_ANY_THROW(mc_pool_get_stats(&pool, NULL));
+    }
+}
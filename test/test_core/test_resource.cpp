@@ -3,6 +3,8 @@
 extern "C"
 {
 #include "mc/resource.h"
+#include "mc/time.h"
+#include "fakes/fake_time.h"
 }
 
 namespace
@@ -129,4 +131,249 @@ namespace
         EXPECT_ANY_THROW(mc_resource_release(NULL, &x));
         EXPECT_ANY_THROW(mc_resource_release_key(NULL, 1));
     }
+
+    // Resource table globals. Bigger than 255 entries on purpose.
+#define TABLE_COUNT 300
+    int32_t values[TABLE_COUNT];
+    mc_resource_entry_t table_pool[TABLE_COUNT];
+    MC_DEFINE_RESOURCE_TABLE(table, table_pool, TABLE_COUNT);
+
+    class ResourceTableTest : public MeeCoreTest
+    {
+    protected:
+        void SetUp() override
+        {
+            MeeCoreTest::SetUp();
+            for (int i = 0; i < TABLE_COUNT; i++)
+            {
+                values[i] = i;
+                table_pool[i].data = &values[i];
+            }
+            mc_resource_table_init(&table);
+        }
+    };
+
+    TEST_F(ResourceTableTest, AcquireGetsFreeResource)
+    {
+        int32_t *res = (int32_t *)mc_resource_table_acquire(&table, 10);
+        EXPECT_EQ(&values[0], res);
+        EXPECT_TRUE(table_pool[0].is_busy);
+        EXPECT_EQ(10, table_pool[0].key);
+
+        res = (int32_t *)mc_resource_table_acquire(&table, 11);
+        EXPECT_EQ(&values[1], res);
+        EXPECT_EQ(2, mc_resource_table_get_used_count(&table));
+    }
+
+    TEST_F(ResourceTableTest, AcquireReturnsExistingIfKeyMatches)
+    {
+        void *res1 = mc_resource_table_acquire(&table, 50);
+        void *res2 = mc_resource_table_acquire(&table, 50);
+        EXPECT_EQ(res1, res2);
+        EXPECT_EQ(1, mc_resource_table_get_used_count(&table));
+    }
+
+    TEST_F(ResourceTableTest, AcquireAllReturnsNullIfFull)
+    {
+        // Keys chosen so many collide in the index.
+        for (int i = 0; i < TABLE_COUNT; i++)
+        {
+            EXPECT_TRUE(mc_resource_table_acquire(&table, i * TABLE_COUNT) !=
+                        NULL);
+        }
+        EXPECT_TRUE(mc_resource_table_acquire(&table, -1) == NULL);
+
+        // Every key is still found.
+        for (int i = 0; i < TABLE_COUNT; i++)
+        {
+            EXPECT_EQ(&values[i],
+                      mc_resource_table_get(&table, i * TABLE_COUNT));
+        }
+    }
+
+    TEST_F(ResourceTableTest, GetReturnsNullIfKeyMissing)
+    {
+        EXPECT_TRUE(mc_resource_table_get(&table, 50) == NULL);
+    }
+
+    TEST_F(ResourceTableTest, ReleaseByResourceFreesSlot)
+    {
+        mc_resource_table_acquire(&table, 1);
+        mc_resource_table_acquire(&table, 2);
+
+        mc_resource_table_release(&table, &values[0]);
+        EXPECT_FALSE(table_pool[0].is_busy);
+        EXPECT_TRUE(mc_resource_table_get(&table, 1) == NULL);
+        EXPECT_EQ(&values[1], mc_resource_table_get(&table, 2));
+
+        // Freed slot gets reused first.
+        EXPECT_EQ(&values[0], mc_resource_table_acquire(&table, 3));
+    }
+
+    TEST_F(ResourceTableTest, ReleaseKeepsOtherKeysReachable)
+    {
+        // Acquire and release keys in an interleaved way so probe runs get
+        // shifted around.
+        for (int i = 0; i < TABLE_COUNT; i++)
+        {
+            mc_resource_table_acquire(&table, i * 7);
+        }
+        for (int i = 0; i < TABLE_COUNT; i += 2)
+        {
+            mc_resource_table_release_key(&table, i * 7);
+        }
+        EXPECT_EQ(TABLE_COUNT / 2, mc_resource_table_get_used_count(&table));
+        for (int i = 0; i < TABLE_COUNT; i++)
+        {
+            void *res = mc_resource_table_get(&table, i * 7);
+            if (i % 2 == 0)
+            {
+                EXPECT_TRUE(res == NULL);
+            }
+            else
+            {
+                EXPECT_EQ(&values[i], res);
+            }
+        }
+
+        // Release of unknown key or resource does nothing.
+        int32_t other = 0;
+        mc_resource_table_release_key(&table, 999999);
+        mc_resource_table_release(&table, &other);
+        EXPECT_EQ(TABLE_COUNT / 2, mc_resource_table_get_used_count(&table));
+    }
+
+    TEST_F(ResourceTableTest, AssertDeathIfNull)
+    {
+        EXPECT_ANY_THROW(mc_resource_table_init(NULL));
+        EXPECT_ANY_THROW(mc_resource_table_acquire(NULL, 1));
+        EXPECT_ANY_THROW(mc_resource_table_get(NULL, 1));
+        EXPECT_ANY_THROW(mc_resource_table_release(NULL, &values[0]));
+        EXPECT_ANY_THROW(mc_resource_table_release_key(NULL, 1));
+        EXPECT_ANY_THROW(mc_resource_table_get_used_count(NULL));
+        EXPECT_ANY_THROW(mc_resource_table_acquire_handle(NULL, 1));
+        EXPECT_ANY_THROW(mc_resource_table_resolve(NULL, 0));
+        EXPECT_ANY_THROW(mc_resource_table_touch(NULL, 0));
+        EXPECT_ANY_THROW(mc_resource_table_release_handle(NULL, 0));
+        EXPECT_ANY_THROW(mc_resource_table_sweep(NULL, 1));
+    }
+
+    TEST_F(ResourceTableTest, HandleResolvesUntilReleased)
+    {
+        mc_resource_handle_t handle =
+            mc_resource_table_acquire_handle(&table, 10);
+        EXPECT_NE(MC_RESOURCE_INVALID_HANDLE, handle);
+        EXPECT_EQ(&values[0], mc_resource_table_resolve(&table, handle));
+
+        // Same key returns the same handle.
+        EXPECT_EQ(handle, mc_resource_table_acquire_handle(&table, 10));
+
+        mc_resource_table_release_handle(&table, handle);
+        EXPECT_TRUE(mc_resource_table_resolve(&table, handle) == NULL);
+        EXPECT_EQ(MC_ERROR_INVALID_ARGS,
+                  mc_resource_table_touch(&table, handle));
+
+        // Slot gets reused, but the old handle stays stale.
+        mc_resource_handle_t new_handle =
+            mc_resource_table_acquire_handle(&table, 11);
+        EXPECT_NE(handle, new_handle);
+        EXPECT_TRUE(mc_resource_table_resolve(&table, handle) == NULL);
+        EXPECT_EQ(&values[0], mc_resource_table_resolve(&table, new_handle));
+
+        // Releasing stale handle does nothing.
+        mc_resource_table_release_handle(&table, handle);
+        EXPECT_EQ(&values[0], mc_resource_table_resolve(&table, new_handle));
+    }
+
+    TEST_F(ResourceTableTest, AcquireHandleReturnsInvalidIfFull)
+    {
+        for (int i = 0; i < TABLE_COUNT; i++)
+        {
+            mc_resource_table_acquire(&table, i);
+        }
+        EXPECT_EQ(MC_RESOURCE_INVALID_HANDLE,
+                  mc_resource_table_acquire_handle(&table, -1));
+        EXPECT_TRUE(mc_resource_table_resolve(&table,
+                                              MC_RESOURCE_INVALID_HANDLE) ==
+                    NULL);
+    }
+
+    // Leased table globals
+    fake_time_ctx_t time_ctx;
+    int32_t lease_values[4];
+    mc_resource_entry_t lease_pool[] = {
+        MC_RESOURCE_ENTRY(lease_values[0]),
+        MC_RESOURCE_ENTRY(lease_values[1]),
+        MC_RESOURCE_ENTRY(lease_values[2]),
+        MC_RESOURCE_ENTRY(lease_values[3])};
+    MC_DEFINE_RESOURCE_TABLE_WITH_LEASE(leased, lease_pool, 4, 100);
+
+    class LeasedResourceTableTest : public MeeCoreTest
+    {
+    protected:
+        void SetUp() override
+        {
+            MeeCoreTest::SetUp();
+            mc_time_init(&fake_time_driver, &time_ctx);
+            mc_resource_table_init(&leased);
+        }
+    };
+
+    TEST_F(LeasedResourceTableTest, LeaseExpiresWithoutTouch)
+    {
+        mc_resource_handle_t handle =
+            mc_resource_table_acquire_handle(&leased, 1);
+        fake_time_set_ms(&time_ctx, 99);
+        EXPECT_TRUE(mc_resource_table_resolve(&leased, handle) != NULL);
+
+        fake_time_set_ms(&time_ctx, 100);
+        EXPECT_TRUE(mc_resource_table_resolve(&leased, handle) == NULL);
+        EXPECT_TRUE(mc_resource_table_get(&leased, 1) == NULL);
+        EXPECT_EQ(0, mc_resource_table_get_used_count(&leased));
+    }
+
+    TEST_F(LeasedResourceTableTest, TouchRenewsLease)
+    {
+        mc_resource_handle_t handle =
+            mc_resource_table_acquire_handle(&leased, 1);
+        fake_time_set_ms(&time_ctx, 90);
+        EXPECT_EQ(MC_OK, mc_resource_table_touch(&leased, handle));
+
+        fake_time_set_ms(&time_ctx, 150);
+        EXPECT_TRUE(mc_resource_table_resolve(&leased, handle) != NULL);
+
+        fake_time_set_ms(&time_ctx, 190);
+        EXPECT_TRUE(mc_resource_table_resolve(&leased, handle) == NULL);
+    }
+
+    TEST_F(LeasedResourceTableTest, SweepReleasesExpiredEntriesInBudget)
+    {
+        mc_resource_table_acquire(&leased, 1);
+        mc_resource_table_acquire(&leased, 2);
+        mc_resource_table_acquire(&leased, 3);
+        fake_time_set_ms(&time_ctx, 50);
+        mc_resource_table_acquire(&leased, 4);
+
+        // Only the first three expired. Budget of 2 only reaches two.
+        fake_time_set_ms(&time_ctx, 120);
+        EXPECT_EQ(2, mc_resource_table_sweep(&leased, 2));
+        EXPECT_EQ(2, mc_resource_table_get_used_count(&leased));
+
+        // Next sweep continues where the last one stopped.
+        EXPECT_EQ(1, mc_resource_table_sweep(&leased, 2));
+        EXPECT_EQ(1, mc_resource_table_get_used_count(&leased));
+        EXPECT_EQ(&lease_values[3], mc_resource_table_get(&leased, 4));
+    }
+
+    TEST_F(LeasedResourceTableTest, AcquireReclaimsExpiredEntriesIfFull)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            mc_resource_table_acquire(&leased, i);
+        }
+        EXPECT_TRUE(mc_resource_table_acquire(&leased, 10) == NULL);
+
+        fake_time_set_ms(&time_ctx, 100);
+        EXPECT_TRUE(mc_resource_table_acquire(&leased, 10) != NULL);
+    }
 }
\ No newline at end of file
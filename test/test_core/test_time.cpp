@@ -45,6 +45,15 @@ namespace
         EXPECT_EQ(4200, now);
     }
 
+    TEST_F(TimeTest, GetUsFallsBackToMs)
+    {
+        ctx.current_time_ms = 42;
+
+        uint32_t now = mc_time_get_us();
+
+        EXPECT_EQ(42000, now);
+    }
+
     TEST_F(TimeTest, DelayDelegatesToDriver)
     {
         ctx.current_time_ms = 1000;